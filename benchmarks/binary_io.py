@@ -0,0 +1,34 @@
+# Times saving and reading a Sound (i.e., a Matrix) as a Praat binary file, with the bulk array readers and writers and with the portable number-by-number code (Praat's debug option 18).
+#
+# Usage: python benchmarks/binary_io.py [megabytes of samples] [directory for temporary file]
+
+import parselmouth
+import numpy as np
+
+import os
+import sys
+import tempfile
+import timeit
+
+
+def main():
+	megabytes = float(sys.argv[1]) if len(sys.argv) > 1 else 1024
+	directory = sys.argv[2] if len(sys.argv) > 2 else None
+	n_channels = 4
+	n_samples = max(1, int(megabytes * 2**20 / 8 / n_channels))
+
+	sound = parselmouth.Sound(np.random.RandomState(42).normal(size=(n_channels, n_samples)), sampling_frequency=44100)
+	with tempfile.TemporaryDirectory(dir=directory) as tmp:
+		file_path = os.path.join(tmp, "benchmark.Sound")
+		for name, debug_option in [("portable", 18), ("bulk", 0)]:
+			parselmouth.praat.call("Debug...", False, debug_option)
+			try:
+				write = min(timeit.repeat(lambda: sound.save_as_binary_file(file_path), number=1, repeat=3))
+				read = min(timeit.repeat(lambda: parselmouth.read(file_path), number=1, repeat=3))
+			finally:
+				parselmouth.praat.call("Debug...", False, 0)
+			print("{:>8}: write {:8.3f} s, read {:8.3f} s ({:.0f} MB)".format(name, write, read, n_channels * n_samples * 8 / 2**20))
+
+
+if __name__ == '__main__':
+	main()
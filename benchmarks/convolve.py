@@ -0,0 +1,34 @@
+# Times Sound.convolve and Sound.cross_correlate of a long recording with a short impulse response, and of two sounds of comparable length.
+#
+# Usage: python benchmarks/convolve.py [minutes of sound] [seconds of impulse response] [number of channels]
+
+import parselmouth
+import numpy as np
+
+import sys
+import timeit
+
+
+def main():
+	duration = 60 * float(sys.argv[1]) if len(sys.argv) > 1 else 600
+	impulse_response_duration = float(sys.argv[2]) if len(sys.argv) > 2 else 2
+	n_channels = int(sys.argv[3]) if len(sys.argv) > 3 else 2
+	sampling_frequency = 44100
+
+	random = np.random.RandomState(42)
+	recording = parselmouth.Sound(random.normal(size=(n_channels, int(duration * sampling_frequency))), sampling_frequency)
+	impulse_response = parselmouth.Sound(random.normal(size=int(impulse_response_duration * sampling_frequency)) * np.exp(-np.arange(int(impulse_response_duration * sampling_frequency)) / sampling_frequency / 0.3), sampling_frequency)
+	half = recording.extract_part(0, duration / 2)
+
+	cases = [
+		("convolve with impulse response", lambda: recording.convolve(impulse_response)),
+		("cross-correlate with impulse response", lambda: impulse_response.cross_correlate(recording)),
+		("convolve two halves", lambda: half.convolve(half)),
+	]
+	for name, run in cases:
+		seconds = min(timeit.repeat(run, number=1, repeat=3))
+		print("{:>40}: {:8.3f} s".format(name, seconds))
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,34 @@
+# Compares the FFT backends of Praat (FFTPACK, and the vectorized FFT with and without AVX2) on sizes from 2^8 to 2^22,
+# through Sound.to_spectrum on sounds with a power of two samples. For the smallest sizes, the times also include the
+# overhead of copying the samples and creating the Spectrum object, which is the same for all backends.
+#
+# Usage: python benchmarks/fft.py [smallest power of two] [largest power of two]
+
+import parselmouth
+import numpy as np
+
+import sys
+import timeit
+
+
+BACKENDS = [("FFTPACK", 52), ("vectorized", 53), ("vectorized AVX2", 0)]  # Melder_debug values
+
+
+def main():
+	smallest = int(sys.argv[1]) if len(sys.argv) > 1 else 8
+	largest = int(sys.argv[2]) if len(sys.argv) > 2 else 22
+
+	print("{:>10}".format("size") + "".join("{:>18}".format(name) for name, _ in BACKENDS))
+	for power in range(smallest, largest + 1):
+		sound = parselmouth.Sound(np.random.RandomState(42).normal(size=2**power), 44100)
+		number = max(1, 2**20 // 2**power)
+		times = []
+		for _, debug in BACKENDS:
+			parselmouth.praat.call("Debug...", False, debug)
+			times.append(min(timeit.repeat(lambda: sound.to_spectrum(fast=False), number=number, repeat=5)) / number)
+		parselmouth.praat.call("Debug...", False, 0)
+		print("{:>10}".format(2**power) + "".join("{:>15.1f} us".format(1e6 * t) for t in times))
+
+
+if __name__ == '__main__':
+	main()
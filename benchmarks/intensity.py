@@ -0,0 +1,27 @@
+# Compares the exact and the fast paths of Sound.to_intensity.
+#
+# Usage: python benchmarks/intensity.py [minutes of sound] [number of channels]
+
+import parselmouth
+import numpy as np
+
+import sys
+import timeit
+
+
+def main():
+	duration = 60 * float(sys.argv[1]) if len(sys.argv) > 1 else 600
+	n_channels = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+	sampling_frequency = 44100
+
+	values = np.random.RandomState(42).normal(0, 0.1, (n_channels, int(duration * sampling_frequency)))
+	sound = parselmouth.Sound(values, sampling_frequency=sampling_frequency)
+
+	for minimum_pitch in [50, 100, 400]:
+		exact, fast = (min(timeit.repeat(lambda: sound.to_intensity(minimum_pitch, fast=fast), number=1, repeat=3)) for fast in [False, True])
+		difference = np.max(np.abs(sound.to_intensity(minimum_pitch).values - sound.to_intensity(minimum_pitch, fast=True).values))
+		print("minimum_pitch={:5} Hz: exact {:8.3f} s, fast {:8.3f} s ({:5.1f}x), max. difference {:.2e} dB".format(minimum_pitch, exact, fast, exact / fast, difference))
+
+
+if __name__ == '__main__':
+	main()
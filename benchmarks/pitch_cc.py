@@ -0,0 +1,26 @@
+# Compares the extended-precision and the fast cross-correlation of Sound.to_pitch_cc.
+#
+# Usage: python benchmarks/pitch_cc.py [minutes of sound]
+
+import parselmouth
+import numpy as np
+
+import os
+import sys
+import timeit
+
+
+def main():
+	minutes = float(sys.argv[1]) if len(sys.argv) > 1 else 1
+	sound = parselmouth.Sound(os.path.join(os.path.dirname(__file__), '..', 'tests', 'data', 'the_north_wind_and_the_sun.wav'))
+	sound = parselmouth.Sound(np.tile(sound.values, int(np.ceil(60 * minutes / sound.duration))), sampling_frequency=sound.sampling_frequency)
+
+	for very_accurate in [False, True]:
+		precise, fast = (min(timeit.repeat(lambda: sound.to_pitch_cc(very_accurate=very_accurate, fast=fast), number=1, repeat=3)) for fast in [False, True])
+		frequencies = [sound.to_pitch_cc(very_accurate=very_accurate, fast=fast).selected_array['frequency'] for fast in [False, True]]
+		difference = np.max(np.abs(frequencies[0] - frequencies[1]))
+		print("very_accurate={!s:5}: precise {:8.3f} s, fast {:8.3f} s ({:5.1f}x), max. difference {:.2e} Hz".format(very_accurate, precise, fast, precise / fast, difference))
+
+
+if __name__ == '__main__':
+	main()
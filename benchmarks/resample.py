@@ -0,0 +1,30 @@
+# Compares the speed and accuracy of the resampling methods of Sound.resample, when downsampling noise and a sine wave from 44.1 to 16 kHz.
+#
+# Usage: python benchmarks/resample.py [minutes of sound] [number of channels]
+
+import parselmouth
+import numpy as np
+
+import sys
+import timeit
+
+
+def main():
+	duration = 60 * float(sys.argv[1]) if len(sys.argv) > 1 else 600
+	n_channels = int(sys.argv[2]) if len(sys.argv) > 2 else 2
+	sampling_frequency, new_frequency = 44100, 16000
+
+	noise = parselmouth.Sound(np.random.RandomState(42).normal(size=(n_channels, int(duration * sampling_frequency))), sampling_frequency)
+	t = (np.arange(10 * sampling_frequency) + 0.5) / sampling_frequency
+	sine = parselmouth.Sound(np.sin(2 * np.pi * 1000 * t), sampling_frequency)
+
+	for method in parselmouth.Sound.ResampleMethod.__members__.values():
+		seconds = min(timeit.repeat(lambda: noise.resample(new_frequency, method=method), number=1, repeat=3))
+		resampled = sine.resample(new_frequency, method=method)
+		interior = slice(new_frequency, -new_frequency)
+		error = np.max(np.abs(resampled.values[0, interior] - np.sin(2 * np.pi * 1000 * resampled.xs()[interior])))
+		print("{:>30}: {:8.3f} s, error of 1 kHz sine {:7.1f} dB".format(str(method), seconds, 20 * np.log10(error)))
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,27 @@
+# Compares creating a Sound from arrays of different types and memory layouts with first converting them to a C-contiguous float64 array.
+#
+# Usage: python benchmarks/sound_construction.py [minutes of sound] [number of channels]
+
+import parselmouth
+import numpy as np
+
+import sys
+import timeit
+
+
+def main():
+	duration = 60 * float(sys.argv[1]) if len(sys.argv) > 1 else 60
+	n_channels = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+	sampling_frequency = 16000
+
+	values = np.random.RandomState(42).uniform(-2**15, 2**15, (n_channels, int(duration * sampling_frequency)))
+
+	for dtype in [np.float64, np.float32, np.int16, np.int32]:
+		for order in ['C', 'F']:
+			array = values.astype(dtype, order=order)
+			converted, direct = (min(timeit.repeat(create, number=1, repeat=3)) for create in [lambda: parselmouth.Sound(np.ascontiguousarray(array, dtype=np.float64), sampling_frequency), lambda: parselmouth.Sound(array, sampling_frequency)])
+			print("{:>7} {}-order: via float64 {:8.3f} s, direct {:8.3f} s ({:5.1f}x)".format(np.dtype(dtype).name, order, converted, direct, converted / direct))
+
+
+if __name__ == '__main__':
+	main()
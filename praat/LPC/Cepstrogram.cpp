@@ -28,6 +28,10 @@
 #include "NUM2.h"
 #include "Sound_and_Spectrum.h"
 #include "Sound_extensions.h"
+#include "MelderThread.h"
+
+#include <atomic>
+#include <vector>
 
 #define TOLOG(x) ((1 / NUMln10) * log ((x) + 1e-30))
 #define TO10LOG(x) ((10 / NUMln10) * log ((x) + 1e-30))
@@ -117,18 +121,38 @@ void PowerCepstrogram_paint (PowerCepstrogram me, Graphics g, double tmin, doubl
 	}
 }
 
+/*
+	Calls analyseFrame (cepstrum, iframe) for every frame, with a copy of the frame in a PowerCepstrum of the calling thread.
+	The frames are divided over the threads in blocks, so analyseFrame should only change things that belong to its own frame.
+*/
+template <typename AnalyseFrame>
+static void PowerCepstrogram_analyseFrames (PowerCepstrogram me, AnalyseFrame analyseFrame) {
+	constexpr integer numberOfFramesPerBlock = 16;
+	const integer numberOfThreads = MelderThread_getNumberOfThreads (my nx, numberOfFramesPerBlock);
+	std::vector <autoPowerCepstrum> cepstra ((size_t) numberOfThreads);
+	for (autoPowerCepstrum& cepstrum : cepstra)
+		cepstrum = PowerCepstrum_create (my ymax, my ny);
+	MelderThread_parallelFor (my nx, numberOfFramesPerBlock, numberOfThreads,
+		[&] (integer firstFrame, integer lastFrame, integer ithread) {
+			PowerCepstrum cepstrum = cepstra [(size_t) ithread - 1]. get();
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				for (integer j = 1; j <= my ny; j ++) {
+					cepstrum -> z [1] [j] = my z [j] [iframe];
+				}
+				analyseFrame (cepstrum, iframe);
+			}
+		}
+	);
+}
+
 void PowerCepstrogram_subtractTilt_inplace (PowerCepstrogram me, double qstartFit, double qendFit, int lineType, int fitMethod) {
 	try {
-		autoPowerCepstrum thee = PowerCepstrum_create (my ymax, my ny);
-		for (integer i = 1; i <= my nx; i ++) {
+		PowerCepstrogram_analyseFrames (me, [&] (PowerCepstrum cepstrum, integer iframe) {
+			PowerCepstrum_subtractTilt_inplace (cepstrum, qstartFit, qendFit, lineType, fitMethod);
 			for (integer j = 1; j <= my ny; j ++) {
-				thy z [1] [j] = my z [j] [i];
+				my z [j] [iframe] = cepstrum -> z [1] [j];
 			}
-			PowerCepstrum_subtractTilt_inplace (thee.get(), qstartFit, qendFit, lineType, fitMethod);
-			for (integer j = 1; j <= my ny; j ++) {
-				my z [j] [i] = thy z [1] [j];
-			}
-		}
+		});
 	} catch (MelderError) {
 		Melder_throw (me, U": no tilt subtracted (inline).");
 	}
@@ -169,20 +193,19 @@ autoTable PowerCepstrogram_to_Table_hillenbrand (PowerCepstrogram me, double pit
 autoTable PowerCepstrogram_to_Table_cpp (PowerCepstrogram me, double pitchFloor, double pitchCeiling, double deltaF0, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod) {
 	try {
 		autoTable thee = Table_createWithColumnNames (my nx, U"time quefrency cpp f0 rnr");
-		autoPowerCepstrum him = PowerCepstrum_create (my ymax, my ny);
+		autoVEC qpeak = VECraw (my nx), cpp = VECraw (my nx), rnr = VECraw (my nx);
+		PowerCepstrogram_analyseFrames (me, [&] (PowerCepstrum cepstrum, integer iframe) {
+			cpp [iframe] = PowerCepstrum_getPeakProminence (cepstrum, pitchFloor, pitchCeiling, interpolation,
+				qstartFit, qendFit, lineType, fitMethod, & qpeak [iframe]);
+			rnr [iframe] = PowerCepstrum_getRNR (cepstrum, pitchFloor, pitchCeiling, deltaF0);
+		});
 		for (integer i = 1; i <= my nx; i ++) {
-			for (integer j = 1; j <= my ny; j ++) {
-				his z [1] [j] = my z [j] [i];
-			}
-			double qpeak, cpp = PowerCepstrum_getPeakProminence (him.get(), pitchFloor, pitchCeiling, interpolation,
-				qstartFit, qendFit, lineType, fitMethod, & qpeak);
-			double rnr = PowerCepstrum_getRNR (him.get(), pitchFloor, pitchCeiling, deltaF0);
 			double time = Sampled_indexToX (me, i);
 			Table_setNumericValue (thee.get(), i, 1, time);
-			Table_setNumericValue (thee.get(), i, 2, qpeak);
-			Table_setNumericValue (thee.get(), i, 3, cpp); // Cepstrogram_getCPPS depends on this index!!
-			Table_setNumericValue (thee.get(), i, 4, 1.0 / qpeak);
-			Table_setNumericValue (thee.get(), i, 5, rnr);
+			Table_setNumericValue (thee.get(), i, 2, qpeak [i]);
+			Table_setNumericValue (thee.get(), i, 3, cpp [i]); // Cepstrogram_getCPPS depends on this index!!
+			Table_setNumericValue (thee.get(), i, 4, 1.0 / qpeak [i]);
+			Table_setNumericValue (thee.get(), i, 5, rnr [i]);
 		}
 		return thee;
 	} catch (MelderError) {
@@ -282,32 +305,93 @@ autoPowerCepstrogram Sound_to_PowerCepstrogram (Sound me, double pitchFloor, dou
 		autoSound sound = Sound_resample (me, samplingFrequency, 50);
 		Sound_preEmphasis (sound.get(), preEmphasisFrequency);
 		Sampled_shortTermAnalysis (me, windowDuration, dt, & nFrames, & t1);
-		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
 		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
+		const integer nsamp_window = window -> nx;
 		// find out the size of the FFT
 		integer nfft = 2;
-		while (nfft < sframe -> nx) nfft *= 2;
+		while (nfft < nsamp_window) nfft *= 2;
 		integer nq = nfft / 2 + 1;
 		double qmax = 0.5 * nfft / samplingFrequency, dq = qmax / (nq - 1);
 		autoPowerCepstrogram thee = PowerCepstrogram_create (my xmin, my xmax, nFrames, dt, t1, 0, qmax, nq, dq, 0);
 
+		/*
+			The same steps as Sound_to_Spectrum, Spectrum_to_PowerCepstrum and Spectrum_to_Sound on each frame,
+			with the same scalings, but in the buffers of the thread, with one FFT table for both directions.
+			A block of frames is written into the PowerCepstrogram row by row.
+		*/
+		const double sampleScaling = window -> dx, spectrumScaling = 1.0 / (window -> dx * nfft);
+		constexpr integer numberOfFramesPerBlock = 32;
+		const integer numberOfThreads = MelderThread_getNumberOfThreads (nFrames, numberOfFramesPerBlock);
+		struct Scratch {
+			autoNUMvector <double> frame, data;
+			autoMAT cepstra;   // [1..numberOfFramesPerBlock] [1..nq]
+			autoNUMfft_Table fftTable;
+		};
+		std::vector <Scratch> scratch ((size_t) numberOfThreads);
+		for (Scratch& s : scratch) {
+			s.frame.reset (1, nsamp_window);
+			s.data.reset (1, nfft);
+			s.cepstra = MATraw (numberOfFramesPerBlock, nq);
+			NUMfft_Table_init (& s.fftTable, nfft);
+		}
 		autoMelderProgress progress (U"Cepstrogram analysis");
+		std::atomic <integer> numberOfFramesDone { 0 };
+		MelderThread_parallelFor (nFrames, numberOfFramesPerBlock, numberOfThreads,
+			[&] (integer firstFrame, integer lastFrame, integer ithread) {
+				double *frame = scratch [(size_t) ithread - 1]. frame.peek();
+				double *data = scratch [(size_t) ithread - 1]. data.peek();
+				MAT cepstra = scratch [(size_t) ithread - 1]. cepstra.get();
+				NUMfft_Table fftTable = & scratch [(size_t) ithread - 1]. fftTable;
+				if (ithread == 1) {   // only the calling thread can talk to the user
+					const integer numberOfFramesDoneSoFar = numberOfFramesDone;
+					Melder_progress ((double) numberOfFramesDoneSoFar / nFrames, U"PowerCepstrogram analysis of frame ",
+						numberOfFramesDoneSoFar + 1, U" out of ", nFrames, U".");
+				}
+				for (integer firstInBlock = firstFrame; firstInBlock <= lastFrame; firstInBlock += numberOfFramesPerBlock) {   // a single thread gets all frames at once
+					const integer lastInBlock = std::min (firstInBlock + numberOfFramesPerBlock - 1, lastFrame);
+					for (integer iframe = firstInBlock; iframe <= lastInBlock; iframe ++) {
+						const double t = Sampled_indexToX (thee.get(), iframe);
+						const integer index = Sampled_xToNearestIndex (sound.get(), t - windowDuration / 2);
+						for (integer i = 1; i <= nsamp_window; i ++) {
+							const integer j = index - 1 + i;
+							frame [i] = ( j < 1 || j > sound -> nx ? 0.0 : sound -> z [1] [j] );
+						}
+						VECcentre_inplace (VEC (frame, nsamp_window));
+						for (integer i = 1; i <= nsamp_window; i ++) {
+							data [i] = frame [i] * window -> z [1] [i];
+						}
+						for (integer i = nsamp_window + 1; i <= nfft; i ++) {
+							data [i] = 0.0;
+						}
+						NUMfft_forward (fftTable, data);
 
-		for (integer iframe = 1; iframe <= nFrames; iframe++) {
-			double t = Sampled_indexToX (thee.get(), iframe);
-			Sound_into_Sound (sound.get(), sframe.get(), t - windowDuration / 2);
-			Vector_subtractMean (sframe.get());
-			Sounds_multiply (sframe.get(), window.get());
-			autoSpectrum spec = Sound_to_Spectrum (sframe.get(), true);   // FFT yes
-			autoPowerCepstrum cepstrum = Spectrum_to_PowerCepstrum (spec.get());
-			for (integer i = 1; i <= nq; i ++) {
-				thy z [i] [iframe] = cepstrum -> z [1] [i];
-			}
-			if ((iframe % 10) == 1) {
-				Melder_progress ((double) iframe / nFrames, U"PowerCepstrogram analysis of frame ",
-					iframe, U" out of ", nFrames, U".");
+						/*
+							The log power spectrum, as the real parts of a spectrum with zero imaginary parts.
+						*/
+						auto logPower = [] (double re, double im) { return log (re * re + im * im + 1e-300); };
+						data [1] = logPower (data [1] * sampleScaling, 0.0) * spectrumScaling;
+						for (integer i = 2; i < nq; i ++) {
+							data [i + i - 2] = logPower (data [i + i - 2] * sampleScaling, data [i + i - 1] * sampleScaling) * spectrumScaling;
+							data [i + i - 1] = 0.0;
+						}
+						data [nfft] = logPower (data [nfft] * sampleScaling, 0.0) * spectrumScaling;
+						NUMfft_backward (fftTable, data);
+
+						double *cepstrum = cepstra [iframe - firstInBlock + 1];
+						for (integer i = 1; i <= nq; i ++) {
+							cepstrum [i] = data [i] * data [i];
+						}
+					}
+					for (integer i = 1; i <= nq; i ++) {
+						double *row = thy z [i];
+						for (integer iframe = firstInBlock; iframe <= lastInBlock; iframe ++) {
+							row [iframe] = cepstra [iframe - firstInBlock + 1] [i];
+						}
+					}
+				}
+				numberOfFramesDone += lastFrame - firstFrame + 1;
 			}
-		}
+		);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no PowerCepstrogram created.");
@@ -456,16 +540,52 @@ autoPowerCepstrogram Sound_to_PowerCepstrogram_hillenbrand (Sound me, double pit
 	}
 }
 
-double PowerCepstrogram_getCPPS (PowerCepstrogram me, bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, double deltaF0, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod) {
+/*
+	The mean of column 3 of PowerCepstrogram_to_Table_cpp on the smoothed PowerCepstrogram, without computing the other columns:
+	the rahmonics-to-noise ratio, with its sinc interpolation of the peak, would take most of the time.
+*/
+static double PowerCepstrogram_getCPPS_afterTilt (PowerCepstrogram me, double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod) {
+	autoPowerCepstrogram smooth = PowerCepstrogram_smooth (me, timeAveragingWindow, quefrencyAveragingWindow);
+	if (smooth -> nx < 1)
+		return undefined;
+	autoVEC cpp = VECraw (smooth -> nx);
+	PowerCepstrogram_analyseFrames (smooth.get(), [&] (PowerCepstrum cepstrum, integer iframe) {
+		cpp [iframe] = PowerCepstrum_getPeakProminence (cepstrum, pitchFloor, pitchCeiling, interpolation,
+			qstartFit, qendFit, lineType, fitMethod, nullptr);
+	});
+	longdouble sum = 0.0;
+	for (integer iframe = 1; iframe <= smooth -> nx; iframe ++) {
+		Melder_require (isdefined (cpp [iframe]),
+			U"The cepstral peak prominence in frame ", iframe, U" is undefined.");
+		sum += cpp [iframe];
+	}
+	return (double) sum / smooth -> nx;
+}
+
+double PowerCepstrogram_getCPPS (PowerCepstrogram me, bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, double /* deltaF0: only for the rahmonics-to-noise ratio */, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod) {
 	try {
 		autoPowerCepstrogram flattened;
 		if (subtractTiltBeforeSmoothing) {
 			flattened = PowerCepstrogram_subtractTilt (me, qstartFit, qendFit, lineType, fitMethod);
 		}
-		autoPowerCepstrogram smooth = PowerCepstrogram_smooth (flattened ? flattened.get() : me, timeAveragingWindow, quefrencyAveragingWindow);
-		autoTable table = PowerCepstrogram_to_Table_cpp (smooth.get(), pitchFloor, pitchCeiling, deltaF0, interpolation, qstartFit, qendFit, lineType, fitMethod);
-		double cpps = Table_getMean (table.get(), 3);
-		return cpps;
+		return PowerCepstrogram_getCPPS_afterTilt (flattened ? flattened.get() : me, timeAveragingWindow, quefrencyAveragingWindow,
+			pitchFloor, pitchCeiling, interpolation, qstartFit, qendFit, lineType, fitMethod);
+	} catch (MelderError) {
+		Melder_throw (me, U": no CPPS value calculated.");
+	}
+}
+
+double Sound_getCPPS (Sound me, double pitchFloor, double dt, double maximumFrequency, double preEmphasisFrequency,
+	bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod)
+{
+	try {
+		autoPowerCepstrogram cepstrogram = Sound_to_PowerCepstrogram (me, pitchFloor, dt, maximumFrequency, preEmphasisFrequency);
+		if (subtractTiltBeforeSmoothing) {
+			PowerCepstrogram_subtractTilt_inplace (cepstrogram.get(), qstartFit, qendFit, lineType, fitMethod);   // nobody else sees this cepstrogram
+		}
+		return PowerCepstrogram_getCPPS_afterTilt (cepstrogram.get(), timeAveragingWindow, quefrencyAveragingWindow,
+			peakSearchPitchFloor, peakSearchPitchCeiling, interpolation, qstartFit, qendFit, lineType, fitMethod);
 	} catch (MelderError) {
 		Melder_throw (me, U": no CPPS value calculated.");
 	}
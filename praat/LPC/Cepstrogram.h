@@ -74,6 +74,13 @@ double PowerCepstrogram_getCPPS_hillenbrand (PowerCepstrogram me, bool subtractT
 
 double PowerCepstrogram_getCPPS (PowerCepstrogram me, bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, double deltaF0, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod);
 
+double Sound_getCPPS (Sound me, double pitchFloor, double dt, double maximumFrequency, double preEmphasisFrequency,
+	bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, int interpolation, double qstartFit, double qendFit, int lineType, int fitMethod);
+/*
+	The same as PowerCepstrogram_getCPPS on the result of Sound_to_PowerCepstrogram, without keeping the cepstrogram.
+*/
+
 autoMatrix PowerCepstrogram_to_Matrix (PowerCepstrogram me);
 
 autoPowerCepstrogram Matrix_to_PowerCepstrogram (Matrix me);
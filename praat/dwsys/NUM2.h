@@ -1068,11 +1068,13 @@ double NUMminimize_brent (double (*f) (double x, void *closure), double a, doubl
 
 /********************** fft ******************************************/
 
+struct structNUMfft_Plan;
+
 struct structNUMfft_Table
 {
   integer n;
-  double *trigcache;
-  integer *splitcache;
+  double *workspace;
+  const structNUMfft_Plan *plan;   // borrowed from the plan cache, and shared with the other tables of this size
 };
 
 typedef struct structNUMfft_Table *NUMfft_Table;
@@ -1080,17 +1082,37 @@ typedef struct structNUMfft_Table *NUMfft_Table;
 void NUMfft_Table_init (NUMfft_Table table, integer n);
 /*
 	n : data size
+	If n is a power of two (of at least 64), the table uses the vectorized real FFT of NUMfft_vectorized.h;
+	if n has a prime factor so large that FFTPACK would be slow (e.g. if n is a large prime), it uses Bluestein's algorithm,
+	a convolution with a chirp through that same FFT;
+	otherwise, or if Melder_debug is 52, it uses FFTPACK. All backends give the same output (up to rounding errors).
+	The trigonometric tables of every size are computed only once, in a process-wide cache, and shared by every table of that size
+	(of powers of two up to 2^20, for the whole session; of other sizes, while they are among the few most recently used ones).
+	A table also contains the workspace of the transform, so every thread needs its own table.
+*/
+
+void NUMfft_Table_free (NUMfft_Table table);
+
+integer NUMfft_getFastSize (integer n);
+/*
+	The smallest size of at least n that has no prime factors other than 2, 3, 5, and 7,
+	for padding data to a length that FFTPACK transforms quickly, with less padding than to a power of two.
+*/
+
+void NUMfft_getPlanCacheStatistics (integer *numberOfHits, integer *numberOfMisses, integer *numberOfPlans, integer *numberOfBytes);
+/*
+	For profiling: how often NUMfft_Table_init found the tables of its size in the cache (hits) or had to compute them (misses),
+	and the number and total size of the plans currently in the cache. Any argument may be null.
 */
 
 struct autoNUMfft_Table : public structNUMfft_Table {
 	autoNUMfft_Table () throw () {
 		n = 0;
-		trigcache = 0;
-		splitcache = 0;
+		workspace = 0;
+		plan = 0;
 	}
 	~autoNUMfft_Table () {
-		NUMvector_free (trigcache, 0);
-		NUMvector_free (splitcache, 0);
+		NUMfft_Table_free (this);
 	}
 };
 
@@ -13,6 +13,7 @@
  djmw 20071201 Latest modification
  pb 20100120 dlamc3_: declare volatile double ret_val to prevent optimization!
  pb 2018 logicals -> bools
+ Parselmouth: the local variables that f2c made static are thread_local, as in NUMclapack.cpp
 */
 
 
@@ -37,7 +38,7 @@ int NUMblas_daxpy (integer *n, double *da, double *dx, integer *incx, double *dy
 	integer i__1;
 
 	/* Local variables */
-	static integer i__, m, ix, iy, mp1;
+	static thread_local integer i__, m, ix, iy, mp1;
 
 	--dy;
 	--dx;
@@ -100,7 +101,7 @@ int NUMblas_dcopy (integer *n, double *dx, integer *incx, double *dy, integer *i
 	integer i__1;
 
 	/* Local variables */
-	static integer i__, m, ix, iy, mp1;
+	static thread_local integer i__, m, ix, iy, mp1;
 
 	--dy;
 	--dx;
@@ -164,9 +165,9 @@ double NUMblas_ddot (integer *n, double *dx, integer *incx, double *dy, integer
 	double ret_val;
 
 	/* Local variables */
-	static integer i__, m;
-	static double dtemp;
-	static integer ix, iy, mp1;
+	static thread_local integer i__, m;
+	static thread_local double dtemp;
+	static thread_local integer ix, iy, mp1;
 
 	/* Parameter adjustments */
 	--dy;
@@ -232,11 +233,11 @@ int NUMblas_dgemm (const char *transa, const char *transb, integer *m, integer *
 	integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer info;
-	static integer nota, notb;
-	static double temp;
-	static integer i__, j, l, ncola;
-	static integer nrowa, nrowb;
+	static thread_local integer info;
+	static thread_local integer nota, notb;
+	static thread_local double temp;
+	static thread_local integer i__, j, l, ncola;
+	static thread_local integer nrowa, nrowb;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -445,9 +446,9 @@ int NUMblas_dger (integer *m, integer *n, double *alpha, double *x, integer *inc
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer i__, j, ix, jy, kx;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer i__, j, ix, jy, kx;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 	/* Test the input parameters. Parameter adjustments */
@@ -531,10 +532,10 @@ int NUMblas_dgemv (const char *trans, integer *m, integer *n, double *alpha, dou
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer lenx, leny, i__, j;
-	static integer ix, iy, jx, jy, kx, ky;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer lenx, leny, i__, j;
+	static thread_local integer ix, iy, jx, jy, kx, ky;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -699,7 +700,7 @@ int NUMblas_dgemv (const char *trans, integer *m, integer *n, double *alpha, dou
 
 double NUMblas_dlamch (const char *cmach) {
 	/* Initialized data */
-	static bool first = true;
+	static thread_local bool first = true;
 
 	/* System generated locals */
 	integer i__1;
@@ -707,15 +708,15 @@ double NUMblas_dlamch (const char *cmach) {
 
 	/* Builtin functions */
 	/* Local variables */
-	static double base;
-	static integer beta;
-	static double emin, prec, emax;
-	static integer imin, imax;
-	static bool lrnd;
-	static double rmin, rmax, t, rmach;
-	static double smal, sfmin;
-	static integer it;
-	static double rnd, eps;
+	static thread_local double base;
+	static thread_local integer beta;
+	static thread_local double emin, prec, emax;
+	static thread_local integer imin, imax;
+	static thread_local bool lrnd;
+	static thread_local double rmin, rmax, t, rmach;
+	static thread_local double smal, sfmin;
+	static thread_local integer it;
+	static thread_local double rnd, eps;
 
 	if (first) {
 		first = false;
@@ -811,20 +812,20 @@ static int dlamc1_ (integer *beta, integer *t, bool *rnd, bool *ieee1) {
 
 	   ===================================================================== */
 	/* Initialized data */
-	static bool first = true;
+	static thread_local bool first = true;
 
 	/* System generated locals */
 	double d__1, d__2;
 
 	/* Local variables */
-	static bool lrnd;
-	static double a, b, c, f;
-	static integer lbeta;
-	static double savec;
-	static bool lieee1;
-	static double t1, t2;
-	static integer lt;
-	static double one, qtr;
+	static thread_local bool lrnd;
+	static thread_local double a, b, c, f;
+	static thread_local integer lbeta;
+	static thread_local double savec;
+	static thread_local bool lieee1;
+	static thread_local double t1, t2;
+	static thread_local integer lt;
+	static thread_local double one, qtr;
 
 	if (first) {
 		first = false;
@@ -987,8 +988,8 @@ static int dlamc2_ (integer *beta, integer *t, bool *rnd, double *eps, integer *
 	   ===================================================================== */
 	/* Table of constant values */
 	/* Initialized data */
-	static bool first = true;
-	static bool iwarn = false;
+	static thread_local bool first = true;
+	static thread_local bool iwarn = false;
 
 	/* System generated locals */
 	integer i__1;
@@ -996,19 +997,19 @@ static int dlamc2_ (integer *beta, integer *t, bool *rnd, double *eps, integer *
 
 	/* Builtin functions */
 	/* Local variables */
-	static bool ieee;
-	static double half;
-	static bool lrnd;
-	static double leps, zero, a, b, c;
-	static integer i, lbeta;
-	static double rbase;
-	static integer lemin, lemax, gnmin;
-	static double smal;
-	static integer gpmin;
-	static double third, lrmin, lrmax, sixth;
-	static bool lieee1;
-	static integer lt, ngnmin, ngpmin;
-	static double one, two;
+	static thread_local bool ieee;
+	static thread_local double half;
+	static thread_local bool lrnd;
+	static thread_local double leps, zero, a, b, c;
+	static thread_local integer i, lbeta;
+	static thread_local double rbase;
+	static thread_local integer lemin, lemax, gnmin;
+	static thread_local double smal;
+	static thread_local integer gpmin;
+	static thread_local double third, lrmin, lrmax, sixth;
+	static thread_local bool lieee1;
+	static thread_local integer lt, ngnmin, ngpmin;
+	static thread_local double one, two;
 
 	if (first) {
 		first = false;
@@ -1230,10 +1231,10 @@ static int dlamc4_ (integer *emin, double *start, integer *base) {
 	double d__1;
 
 	/* Local variables */
-	static double zero, a;
-	static integer i;
-	static double rbase, b1, b2, c1, c2, d1, d2;
-	static double one;
+	static thread_local double zero, a;
+	static thread_local integer i;
+	static thread_local double rbase, b1, b2, c1, c2, d1, d2;
+	static thread_local double one;
 
 	a = *start;
 	one = 1.;
@@ -1286,20 +1287,20 @@ static int dlamc5_ (integer *beta, integer *p, integer *emin, bool *ieee, intege
 	   that is closest to abs(EMIN). (EMAX is the exponent of the required
 	   number RMAX). */
 	/* Table of constant values */
-	static double c_b5 = 0.;
+	static thread_local double c_b5 = 0.;
 
 	/* System generated locals */
 	integer i__1;
 	double d__1;
 
 	/* Local variables */
-	static integer lexp;
-	static double oldy;
-	static integer uexp, i;
-	static double y, z;
-	static integer nbits;
-	static double recbas;
-	static integer exbits, expsum, try__;
+	static thread_local integer lexp;
+	static thread_local double oldy;
+	static thread_local integer uexp, i;
+	static thread_local double y, z;
+	static thread_local integer nbits;
+	static thread_local double recbas;
+	static thread_local integer exbits, expsum, try__;
 
 	lexp = 1;
 	exbits = 1;
@@ -1397,9 +1398,9 @@ double NUMblas_dnrm2 (integer *n, double *x, integer *incx) {
 	double ret_val, d__1;
 
 	/* Local variables */
-	static double norm, scale, absxi;
-	static integer ix;
-	static double ssq;
+	static thread_local double norm, scale, absxi;
+	static thread_local integer ix;
+	static thread_local double ssq;
 
 	--x;
 	/* Function Body */
@@ -1441,9 +1442,9 @@ int NUMblas_drot (integer *n, double *dx, integer *incx, double *dy, integer *in
 	integer i__1;
 
 	/* Local variables */
-	static integer i__;
-	static double dtemp;
-	static integer ix, iy;
+	static thread_local integer i__;
+	static thread_local double dtemp;
+	static thread_local integer ix, iy;
 
 	/* applies a plane rotation. jack dongarra, linpack, 3/11/78. modified
 	   12/3/93, array(1) declarations changed to array(*) Parameter
@@ -1494,7 +1495,7 @@ int NUMblas_dscal (integer *n, double *da, double *dx, integer *incx) {
 	integer i__1, i__2;
 
 	/* Local variables */
-	static integer i__, m, nincx, mp1;
+	static thread_local integer i__, m, nincx, mp1;
 
 	/* Parameter adjustments */
 	--dx;
@@ -1547,9 +1548,9 @@ int NUMblas_dswap (integer *n, double *dx, integer *incx, double *dy, integer *i
 	integer i__1;
 
 	/* Local variables */
-	static integer i__, m;
-	static double dtemp;
-	static integer ix, iy, mp1;
+	static thread_local integer i__, m;
+	static thread_local double dtemp;
+	static thread_local integer ix, iy, mp1;
 
 	/* interchanges two vectors. uses unrolled loops for increments equal
 	   one. jack dongarra, linpack, 3/11/78. modified 12/3/93, array(1)
@@ -1622,10 +1623,10 @@ int NUMblas_dsymv (const char *uplo, integer *n, double *alpha, double *a, integ
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp1, temp2;
-	static integer i__, j;
-	static integer ix, iy, jx, jy, kx, ky;
+	static thread_local integer info;
+	static thread_local double temp1, temp2;
+	static thread_local integer i__, j;
+	static thread_local integer ix, iy, jx, jy, kx, ky;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -1798,10 +1799,10 @@ int NUMblas_dsyr2 (const char *uplo, integer *n, double *alpha, double *x, integ
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp1, temp2;
-	static integer i__, j;
-	static integer ix, iy, jx, jy, kx, ky;
+	static thread_local integer info;
+	static thread_local double temp1, temp2;
+	static thread_local integer i__, j;
+	static thread_local integer ix, iy, jx, jy, kx, ky;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -1935,11 +1936,11 @@ int NUMblas_dsyr2k (const char *uplo, const char *trans, integer *n, integer *k,
 	integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer info;
-	static double temp1, temp2;
-	static integer i__, j, l;
-	static integer nrowa;
-	static integer upper;
+	static thread_local integer info;
+	static thread_local double temp1, temp2;
+	static thread_local integer i__, j, l;
+	static thread_local integer nrowa;
+	static thread_local integer upper;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2163,13 +2164,13 @@ int NUMblas_dtrmm (const char *side, const char *uplo, const char *transa, const
 	integer a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer i__, j, k;
-	static integer lside;
-	static integer nrowa;
-	static integer upper;
-	static integer nounit;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer i__, j, k;
+	static thread_local integer lside;
+	static thread_local integer nrowa;
+	static thread_local integer upper;
+	static thread_local integer nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2444,11 +2445,11 @@ int NUMblas_dtrmv (const char *uplo, const char *trans, const char *diag, intege
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer i__, j;
-	static integer ix, jx, kx;
-	static integer nounit;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer i__, j;
+	static thread_local integer ix, jx, kx;
+	static thread_local integer nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 	/* -- Written on 22-October-1986. Jack Dongarra, Argonne National Lab.
@@ -2653,13 +2654,13 @@ int NUMblas_dtrsm (const char *side, const char *uplo, const char *transa, const
 	integer a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer i__, j, k;
-	static integer lside;
-	static integer nrowa;
-	static integer upper;
-	static integer nounit;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer i__, j, k;
+	static thread_local integer lside;
+	static thread_local integer nrowa;
+	static thread_local integer upper;
+	static thread_local integer nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2960,8 +2961,8 @@ integer NUMblas_idamax (integer *n, double *dx, integer *incx) {
 	double d__1;
 
 	/* Local variables */
-	static double dmax__;
-	static integer i__, ix;
+	static thread_local double dmax__;
+	static thread_local integer i__, ix;
 
 	/* finds the index of element having max. absolute value. jack
 	   dongarra, linpack, 3/11/78. modified 3/93 to return if incx .le. 0.
@@ -9,6 +9,8 @@
 
  djmw 20030205 Latest modification
 */
+/* Parselmouth: the local variables that f2c made static are thread_local,
+   so that analyses running concurrently (e.g. finding formants as polynomial roots) do not share them. */
 /* #include "blaswrap.h" */
 #include "NUMf2c.h"
 #include "NUMclapack.h"
@@ -55,32 +57,32 @@ int NUMlapack_dbdsqr (const char *uplo, integer *n, integer *ncvt, integer *nru,
 	double d__1, d__2, d__3, d__4;
 
 	/* Local variables */
-	static double abse;
-	static integer idir;
-	static double abss;
-	static integer oldm;
-	static double cosl;
-	static integer isub, iter;
-	static double unfl, sinl, cosr, smin, smax, sinr;
-	static double f, g, h__;
-	static integer i__, j, m;
-	static double r__;
-	static double oldcs;
-	static integer oldll;
-	static double shift, sigmn, oldsn;
-	static integer maxit;
-	static double sminl, sigmx;
-	static integer lower;
-	static double cs;
-	static integer ll;
-	static double sn, mu;
-	static double sminoa, thresh;
-	static integer rotate;
-	static double sminlo;
-	static integer nm1;
-	static double tolmul;
-	static integer nm12, nm13, lll;
-	static double eps, sll, tol;
+	static thread_local double abse;
+	static thread_local integer idir;
+	static thread_local double abss;
+	static thread_local integer oldm;
+	static thread_local double cosl;
+	static thread_local integer isub, iter;
+	static thread_local double unfl, sinl, cosr, smin, smax, sinr;
+	static thread_local double f, g, h__;
+	static thread_local integer i__, j, m;
+	static thread_local double r__;
+	static thread_local double oldcs;
+	static thread_local integer oldll;
+	static thread_local double shift, sigmn, oldsn;
+	static thread_local integer maxit;
+	static thread_local double sminl, sigmx;
+	static thread_local integer lower;
+	static thread_local double cs;
+	static thread_local integer ll;
+	static thread_local double sn, mu;
+	static thread_local double sminoa, thresh;
+	static thread_local integer rotate;
+	static thread_local double sminlo;
+	static thread_local integer nm1;
+	static thread_local double tolmul;
+	static thread_local integer nm12, nm13, lll;
+	static thread_local double eps, sll, tol;
 
 	/* Parameter adjustments */
 	--d__;
@@ -748,13 +750,13 @@ L220:
 int NUMlapack_dgebd2 (integer *m, integer *n, double *a, integer *lda, double *d__, double *e, double *tauq,
                       double *taup, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__;
+	static thread_local integer i__;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -890,11 +892,11 @@ int NUMlapack_dgebak (const char *job, const char *side, integer *n, integer *il
 	integer v_dim1, v_offset, i__1;
 
 	/* Local variables */
-	static integer i__, k;
-	static double s;
-	static int leftv;
-	static integer ii;
-	static int rightv;
+	static thread_local integer i__, k;
+	static thread_local double s;
+	static thread_local int leftv;
+	static thread_local integer ii;
+	static thread_local int rightv;
 
 #define v_ref(a_1,a_2) v[(a_2)*v_dim1 + a_1]
 
@@ -1024,20 +1026,20 @@ L50:
 int NUMlapack_dgebal (const char *job, integer *n, double *a, integer *lda, integer *ilo, integer *ihi, double *scale,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 	double d__1, d__2;
 
 	/* Local variables */
-	static integer iexc;
-	static double c__, f, g;
-	static integer i__, j, k, l, m;
-	static double r__, s;
-	static double sfmin1, sfmin2, sfmax1, sfmax2, ca, ra;
-	static int noconv;
-	static integer ica, ira;
+	static thread_local integer iexc;
+	static thread_local double c__, f, g;
+	static thread_local integer i__, j, k, l, m;
+	static thread_local double r__, s;
+	static thread_local double sfmin1, sfmin2, sfmax1, sfmax2, ca, ra;
+	static thread_local int noconv;
+	static thread_local integer ica, ira;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1289,24 +1291,24 @@ L210:
 int NUMlapack_dgebrd (integer *m, integer *n, double *a, integer *lda, double *d__, double *e, double *tauq,
                       double *taup, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
-	static double c_b21 = -1.;
-	static double c_b22 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
+	static thread_local double c_b21 = -1.;
+	static thread_local double c_b22 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer nbmin, iinfo, minmn;
-	static integer nb;
-	static integer nx;
-	static double ws;
-	static integer ldwrkx, ldwrky, lwkopt;
-	static integer lquery;
+	static thread_local integer i__, j;
+	static thread_local integer nbmin, iinfo, minmn;
+	static thread_local integer nb;
+	static thread_local integer nx;
+	static thread_local double ws;
+	static thread_local integer ldwrkx, ldwrky, lwkopt;
+	static thread_local integer lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1447,37 +1449,37 @@ int NUMlapack_dgebrd (integer *m, integer *n, double *a, integer *lda, double *d
 int NUMlapack_dgeev (const char *jobvl, const char *jobvr, integer *n, double *a, integer *lda, double *wr, double *wi,
                      double *vl, integer *ldvl, double *vr, integer *ldvr, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__8 = 8;
-	static integer c_n1 = -1;
+	static thread_local integer c__8 = 8;
+	static thread_local integer c_n1 = -1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, vl_dim1, vl_offset, vr_dim1, vr_offset, i__1, i__2, i__3, i__4;
 	double d__1, d__2;
 
 	/* Local variables */
-	static integer ibal;
-	static char side[1];
-	static integer maxb;
-	static double anrm;
-	static integer ierr, itau;
-	static integer iwrk, nout;
-	static integer i__, k;
-	static double r__;
-	static double cs;
-	static int scalea;
-	static double cscale;
-	static double sn;
-	static int select[1];
-	static double bignum;
-	static integer minwrk, maxwrk;
-	static int wantvl;
-	static double smlnum;
-	static integer hswork;
-	static int lquery, wantvr;
-	static integer ihi;
-	static double scl;
-	static integer ilo;
-	static double dum[1], eps;
+	static thread_local integer ibal;
+	static thread_local char side[1];
+	static thread_local integer maxb;
+	static thread_local double anrm;
+	static thread_local integer ierr, itau;
+	static thread_local integer iwrk, nout;
+	static thread_local integer i__, k;
+	static thread_local double r__;
+	static thread_local double cs;
+	static thread_local int scalea;
+	static thread_local double cscale;
+	static thread_local double sn;
+	static thread_local int select[1];
+	static thread_local double bignum;
+	static thread_local integer minwrk, maxwrk;
+	static thread_local int wantvl;
+	static thread_local double smlnum;
+	static thread_local integer hswork;
+	static thread_local int lquery, wantvr;
+	static thread_local integer ihi;
+	static thread_local double scl;
+	static thread_local integer ilo;
+	static thread_local double dum[1], eps;
 
 #define vl_ref(a_1,a_2) vl[(a_2)*vl_dim1 + a_1]
 #define vr_ref(a_1,a_2) vr[(a_2)*vr_dim1 + a_1]
@@ -1806,14 +1808,14 @@ L50:
 int NUMlapack_dgehd2 (integer *n, integer *ilo, integer *ihi, double *a, integer *lda, double *tau, double *work,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__;
-	static double aii;
+	static thread_local integer i__;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1874,28 +1876,28 @@ int NUMlapack_dgehd2 (integer *n, integer *ilo, integer *ihi, double *a, integer
 int NUMlapack_dgehrd (integer *n, integer *ilo, integer *ihi, double *a, integer *lda, double *tau, double *work,
                       integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
-	static integer c__65 = 65;
-	static double c_b25 = -1.;
-	static double c_b26 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
+	static thread_local integer c__65 = 65;
+	static thread_local double c_b25 = -1.;
+	static thread_local double c_b26 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__;
-	static double t[4160] /* was [65][64] */ ;
-	static integer nbmin, iinfo;
-	static integer ib;
-	static double ei;
-	static integer nb, nh;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static int lquery;
-	static integer iws;
+	static thread_local integer i__;
+	static thread_local double t[4160] /* was [65][64] */ ;
+	static thread_local integer nbmin, iinfo;
+	static thread_local integer ib;
+	static thread_local double ei;
+	static thread_local integer nb, nh;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local int lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2049,8 +2051,8 @@ int NUMlapack_dgelq2 (integer *m, integer *n, double *a, integer *lda, double *t
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, k;
-	static double aii;
+	static thread_local integer i__, k;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2104,21 +2106,21 @@ int NUMlapack_dgelq2 (integer *m, integer *n, double *a, integer *lda, double *t
 int NUMlapack_dgelqf (integer *m, integer *n, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__, k, nbmin, iinfo;
-	static integer ib, nb;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, k, nbmin, iinfo;
+	static thread_local integer ib, nb;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2245,24 +2247,24 @@ int NUMlapack_dgelss (integer *m, integer *n, integer *nrhs, double *a, integer
 	double d__1;
 
 	/* Local variables */
-	static double anrm, bnrm;
-	static integer itau;
-	static double vdum[1];
-	static integer i__;
-	static integer iascl, ibscl;
-	static integer chunk;
-	static double sfmin;
-	static integer minmn;
-	static integer maxmn, itaup, itauq, mnthr, iwork;
-	static integer bl, ie, il;
-	static integer mm;
-	static integer bdspac;
-	static double bignum;
-	static integer ldwork;
-	static integer minwrk, maxwrk;
-	static double smlnum;
-	static integer lquery;
-	static double eps, thr;
+	static thread_local double anrm, bnrm;
+	static thread_local integer itau;
+	static thread_local double vdum[1];
+	static thread_local integer i__;
+	static thread_local integer iascl, ibscl;
+	static thread_local integer chunk;
+	static thread_local double sfmin;
+	static thread_local integer minmn;
+	static thread_local integer maxmn, itaup, itauq, mnthr, iwork;
+	static thread_local integer bl, ie, il;
+	static thread_local integer mm;
+	static thread_local integer bdspac;
+	static thread_local double bignum;
+	static thread_local integer ldwork;
+	static thread_local integer minwrk, maxwrk;
+	static thread_local double smlnum;
+	static thread_local integer lquery;
+	static thread_local double eps, thr;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2847,20 +2849,20 @@ L70:
 
 int NUMlapack_dgeqpf (integer *m, integer *n, double *a, integer *lda, integer *jpvt, double *tau, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp;
-	static double temp2;
-	static integer i__, j;
-	static integer itemp;
-	static integer ma, mn;
-	static double aii;
-	static integer pvt;
+	static thread_local double temp;
+	static thread_local double temp2;
+	static thread_local integer i__, j;
+	static thread_local integer itemp;
+	static thread_local integer ma, mn;
+	static thread_local double aii;
+	static thread_local integer pvt;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3009,14 +3011,14 @@ int NUMlapack_dgeqpf (integer *m, integer *n, double *a, integer *lda, integer *
 
 int NUMlapack_dgeqr2 (integer *m, integer *n, double *a, integer *lda, double *tau, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, k;
-	static double aii;
+	static thread_local integer i__, k;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3070,21 +3072,21 @@ int NUMlapack_dgeqr2 (integer *m, integer *n, double *a, integer *lda, double *t
 int NUMlapack_dgeqrf (integer *m, integer *n, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__, k, nbmin, iinfo;
-	static integer ib, nb;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, k, nbmin, iinfo;
+	static thread_local integer ib, nb;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3207,8 +3209,8 @@ int NUMlapack_dgerq2 (integer *m, integer *n, double *a, integer *lda, double *t
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer i__, k;
-	static double aii;
+	static thread_local integer i__, k;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3309,20 +3311,20 @@ int NUMlapack_dgesvd (const char *jobu, const char *jobvt, integer *m, integer *
 	char ch__1[2];
 
 	/* Local variables */
-	static integer iscl;
-	static double anrm;
-	static integer ierr, itau, ncvt, nrvt, i__;
-	static integer chunk, minmn, wrkbl, itaup, itauq, mnthr, iwork;
-	static integer wntua, wntva, wntun, wntuo, wntvn, wntvo, wntus, wntvs;
-	static integer ie;
-	static integer ir, bdspac, iu;
-	static double bignum;
-	static integer ldwrkr, minwrk, ldwrku, maxwrk;
-	static double smlnum;
-	static integer lquery, wntuas, wntvas;
-	static integer blk, ncu;
-	static double dum[1], eps;
-	static integer nru;
+	static thread_local integer iscl;
+	static thread_local double anrm;
+	static thread_local integer ierr, itau, ncvt, nrvt, i__;
+	static thread_local integer chunk, minmn, wrkbl, itaup, itauq, mnthr, iwork;
+	static thread_local integer wntua, wntva, wntun, wntuo, wntvn, wntvo, wntus, wntvs;
+	static thread_local integer ie;
+	static thread_local integer ir, bdspac, iu;
+	static thread_local double bignum;
+	static thread_local integer ldwrkr, minwrk, ldwrku, maxwrk;
+	static thread_local double smlnum;
+	static thread_local integer lquery, wntuas, wntvas;
+	static thread_local integer blk, ncu;
+	static thread_local double dum[1], eps;
+	static thread_local integer nru;
 
 	/* Parameter adjustments */
 	a_dim1 = *lda;
@@ -6839,16 +6841,16 @@ int NUMlapack_dgesvd (const char *jobu, const char *jobvt, integer *m, integer *
 
 int NUMlapack_dgetf2 (integer *m, integer *n, double *a, integer *lda, integer *ipiv, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static double c_b6 = -1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b6 = -1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 	double d__1;
 
 	/* Local variables */
-	static integer j;
-	static integer jp;
+	static thread_local integer j;
+	static thread_local integer jp;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -6921,23 +6923,23 @@ int NUMlapack_dgetf2 (integer *m, integer *n, double *a, integer *lda, integer *
 
 int NUMlapack_dgetri (integer *n, double *a, integer *lda, integer *ipiv, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
-	static double c_b20 = -1.;
-	static double c_b22 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
+	static thread_local double c_b20 = -1.;
+	static thread_local double c_b22 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer nbmin;
-	static integer jb, nb, jj, jp, nn;
-	static integer ldwork;
-	static integer lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, j;
+	static thread_local integer nbmin;
+	static thread_local integer jb, nb, jj, jp, nn;
+	static thread_local integer ldwork;
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7076,18 +7078,18 @@ int NUMlapack_dgetri (integer *n, double *a, integer *lda, integer *ipiv, double
 
 int NUMlapack_dgetrf (integer *m, integer *n, double *a, integer *lda, integer *ipiv, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static double c_b16 = 1.;
-	static double c_b19 = -1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local double c_b16 = 1.;
+	static thread_local double c_b19 = -1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4, i__5;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer iinfo;
-	static integer jb, nb;
+	static thread_local integer i__, j;
+	static thread_local integer iinfo;
+	static thread_local integer jb, nb;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7191,15 +7193,15 @@ int NUMlapack_dgetrf (integer *m, integer *n, double *a, integer *lda, integer *
 int NUMlapack_dgetrs (const char *trans, integer *n, integer *nrhs, double *a, integer *lda, integer *ipiv, double *b, integer *ldb,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static double c_b12 = 1.;
-	static integer c_n1 = -1;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b12 = 1.;
+	static thread_local integer c_n1 = -1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, b_dim1, b_offset, i__1;
 
 	/* Local variables */
-	static integer notran;
+	static thread_local integer notran;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7277,21 +7279,21 @@ int NUMlapack_dggsvd (const char *jobu, const char *jobv, const char *jobq, inte
                       double *a, integer *lda, double *b, integer *ldb, double *alpha, double *beta, double *u, integer *ldu, double *v,
                       integer *ldv, double *q, integer *ldq, double *work, integer *iwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, b_dim1, b_offset, q_dim1, q_offset, u_dim1, u_offset, v_dim1, v_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer ibnd;
-	static double tola;
-	static integer isub;
-	static double tolb, unfl, temp, smax;
-	static integer i__, j;
-	static double anorm, bnorm;
-	static integer wantq, wantu, wantv;
-	static integer ncycle;
-	static double ulp;
+	static thread_local integer ibnd;
+	static thread_local double tola;
+	static thread_local integer isub;
+	static thread_local double tolb, unfl, temp, smax;
+	static thread_local integer i__, j;
+	static thread_local double anorm, bnorm;
+	static thread_local integer wantq, wantu, wantv;
+	static thread_local integer ncycle;
+	static thread_local double ulp;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7416,8 +7418,8 @@ int NUMlapack_dggsvp (const char *jobu, const char *jobv, const char *jobq, inte
                       double *b, integer *ldb, double *tola, double *tolb, integer *k, integer *l, double *u, integer *ldu, double *v,
                       integer *ldv, double *q, integer *ldq, integer *iwork, double *tau, double *work, integer *info) {
 	/* Table of constant values */
-	static double c_b12 = 0.;
-	static double c_b22 = 1.;
+	static thread_local double c_b12 = 0.;
+	static thread_local double c_b22 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, b_dim1, b_offset, q_dim1, q_offset, u_dim1, u_offset, v_dim1, v_offset, i__1, i__2,
@@ -7425,9 +7427,9 @@ int NUMlapack_dggsvp (const char *jobu, const char *jobv, const char *jobq, inte
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer wantq, wantu, wantv;
-	static integer forwrd;
+	static thread_local integer i__, j;
+	static thread_local integer wantq, wantu, wantv;
+	static thread_local integer forwrd;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7732,15 +7734,15 @@ int NUMlapack_dggsvp (const char *jobu, const char *jobv, const char *jobq, inte
 int NUMlapack_dhseqr (const char *job, const char *compz, integer *n, integer *ilo, integer *ihi, double *h__, integer *ldh,
                       double *wr, double *wi, double *z__, integer *ldz, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static double c_b9 = 0.;
-	static double c_b10 = 1.;
-	static integer c__4 = 4;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
-	static integer c__8 = 8;
-	static integer c__15 = 15;
-	static int c_false = FALSE;
-	static integer c__1 = 1;
+	static thread_local double c_b9 = 0.;
+	static thread_local double c_b10 = 1.;
+	static thread_local integer c__4 = 4;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
+	static thread_local integer c__8 = 8;
+	static thread_local integer c__15 = 15;
+	static thread_local int c_false = FALSE;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	const char *a__1[2];
@@ -7749,25 +7751,25 @@ int NUMlapack_dhseqr (const char *job, const char *compz, integer *n, integer *i
 	char ch__1[2];
 
 	/* Local variables */
-	static integer maxb;
-	static double absw;
-	static integer ierr;
-	static double unfl, temp, ovfl;
-	static integer i__, j, k, l;
-	static double s[225] /* was [15][15] */ , v[16];
-	static integer itemp;
-	static integer i1, i2;
-	static int initz, wantt, wantz;
-	static integer ii, nh;
-	static integer nr, ns;
-	static integer nv;
-	static double vv[16];
-	static double smlnum;
-	static int lquery;
-	static integer itn;
-	static double tau;
-	static integer its;
-	static double ulp, tst1;
+	static thread_local integer maxb;
+	static thread_local double absw;
+	static thread_local integer ierr;
+	static thread_local double unfl, temp, ovfl;
+	static thread_local integer i__, j, k, l;
+	static thread_local double s[225] /* was [15][15] */ , v[16];
+	static thread_local integer itemp;
+	static thread_local integer i1, i2;
+	static thread_local int initz, wantt, wantz;
+	static thread_local integer ii, nh;
+	static thread_local integer nr, ns;
+	static thread_local integer nv;
+	static thread_local double vv[16];
+	static thread_local double smlnum;
+	static thread_local int lquery;
+	static thread_local integer itn;
+	static thread_local double tau;
+	static thread_local integer its;
+	static thread_local double ulp, tst1;
 
 #define h___ref(a_1,a_2) h__[(a_2)*h_dim1 + a_1]
 #define s_ref(a_1,a_2) s[(a_2)*15 + a_1 - 16]
@@ -8181,16 +8183,16 @@ int NUMlapack_dlabad (double *smal, double *large) {
 int NUMlapack_dlabrd (integer *m, integer *n, integer *nb, double *a, integer *lda, double *d__, double *e, double *tauq,
                       double *taup, double *x, integer *ldx, double *y, integer *ldy) {
 	/* Table of constant values */
-	static double c_b4 = -1.;
-	static double c_b5 = 1.;
-	static integer c__1 = 1;
-	static double c_b16 = 0.;
+	static thread_local double c_b4 = -1.;
+	static thread_local double c_b5 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b16 = 0.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, x_dim1, x_offset, y_dim1, y_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__;
+	static thread_local integer i__;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -8420,7 +8422,7 @@ int NUMlapack_dlacpy (const char *uplo, integer *m, integer *n, double *a, integ
 	integer a_dim1, a_offset, b_dim1, b_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer i__, j;
+	static thread_local integer i__, j;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -8468,7 +8470,7 @@ int NUMlapack_dlacpy (const char *uplo, integer *m, integer *n, double *a, integ
 
 
 int NUMlapack_dladiv (double *a, double *b, double *c, double *d, double *p, double *q) {
-	static double e, f;
+	static thread_local double e, f;
 
 	if (fabs (*d) < fabs (*c)) {
 		e = *d / *c;
@@ -8491,7 +8493,7 @@ int NUMlapack_dlae2 (double *a, double *b, double *c__, double *rt1, double *rt2
 	double d__1;
 
 	/* Local variables */
-	static double acmn, acmx, ab, df, tb, sm, rt, adf;
+	static thread_local double acmn, acmx, ab, df, tb, sm, rt, adf;
 	sm = *a + *c__;
 	df = *a - *c__;
 	adf = fabs (df);
@@ -8548,8 +8550,8 @@ int NUMlapack_dlaev2 (double *a, double *b, double *c__, double *rt1, double *rt
 	double d__1;
 
 	/* Local variables */
-	static double acmn, acmx, ab, df, cs, ct, tb, sm, tn, rt, adf, acs;
-	static integer sgn1, sgn2;
+	static thread_local double acmn, acmx, ab, df, cs, ct, tb, sm, tn, rt, adf, acs;
+	static thread_local integer sgn1, sgn2;
 
 	sm = *a + *c__;
 	df = *a - *c__;
@@ -8640,9 +8642,9 @@ int NUMlapack_dlags2 (integer *upper, double *a1, double *a2, double *a3, double
 	double d__1;
 
 	/* Local variables */
-	static double aua11, aua12, aua21, aua22, avb11, avb12, avb21, avb22;
+	static thread_local double aua11, aua12, aua21, aua22, avb11, avb12, avb21, avb22;
 	double ua11r, ua22r, vb11r, vb22r, a, b, c__, d__, r__, s1, s2;
-	static double ua11, ua12, ua21, ua22, vb11, vb12, vb21, vb22, csl, csr, snl, snr;
+	static thread_local double ua11, ua12, ua21, ua22, vb11, vb12, vb21, vb22, csl, csr, snl, snr;
 
 	if (*upper) {
 
@@ -8817,28 +8819,28 @@ int NUMlapack_dlags2 (integer *upper, double *a1, double *a2, double *a3, double
 int NUMlapack_dlahqr (int *wantt, int *wantz, integer *n, integer *ilo, integer *ihi, double *h__, integer *ldh,
                       double *wr, double *wi, integer *iloz, integer *ihiz, double *z__, integer *ldz, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer h_dim1, h_offset, z_dim1, z_offset, i__1, i__2, i__3, i__4;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double h43h34, disc, unfl, ovfl;
-	static double work[1];
-	static integer i__, j, k, l, m;
-	static double s, v[3];
-	static integer i1, i2;
-	static double t1, t2, t3, v1, v2, v3;
-	static double h00, h10, h11, h12, h21, h22, h33, h44;
-	static integer nh;
-	static double cs;
-	static integer nr;
-	static double sn;
-	static integer nz;
-	static double smlnum, ave, h33s, h44s;
-	static integer itn, its;
-	static double ulp, sum, tst1;
+	static thread_local double h43h34, disc, unfl, ovfl;
+	static thread_local double work[1];
+	static thread_local integer i__, j, k, l, m;
+	static thread_local double s, v[3];
+	static thread_local integer i1, i2;
+	static thread_local double t1, t2, t3, v1, v2, v3;
+	static thread_local double h00, h10, h11, h12, h21, h22, h33, h44;
+	static thread_local integer nh;
+	static thread_local double cs;
+	static thread_local integer nr;
+	static thread_local double sn;
+	static thread_local integer nz;
+	static thread_local double smlnum, ave, h33s, h44s;
+	static thread_local integer itn, its;
+	static thread_local double ulp, sum, tst1;
 
 #define h___ref(a_1,a_2) h__[(a_2)*h_dim1 + a_1]
 #define z___ref(a_1,a_2) z__[(a_2)*z_dim1 + a_1]
@@ -9203,18 +9205,18 @@ L150:
 int NUMlapack_dlahrd (integer *n, integer *k, integer *nb, double *a, integer *lda, double *tau, double *t, integer *ldt,
                       double *y, integer *ldy) {
 	/* Table of constant values */
-	static double c_b4 = -1.;
-	static double c_b5 = 1.;
-	static integer c__1 = 1;
-	static double c_b38 = 0.;
+	static thread_local double c_b4 = -1.;
+	static thread_local double c_b5 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b38 = 0.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, t_dim1, t_offset, y_dim1, y_offset, i__1, i__2, i__3;
 	double d__1;
 
 	/* Local variables */
-	static integer i__;
-	static double ei;
+	static thread_local integer i__;
+	static thread_local double ei;
 
 #define t_ref(a_1,a_2) t[(a_2)*t_dim1 + a_1]
 #define y_ref(a_1,a_2) y[(a_2)*y_dim1 + a_1]
@@ -9340,29 +9342,29 @@ int NUMlapack_dlaln2 (int *ltrans, integer *na, integer *nw, double *smin, doubl
                       double *d1, double *d2, double *b, integer *ldb, double *wr, double *wi, double *x, integer *ldx, double *scale,
                       double *xnorm, integer *info) {
 	/* Initialized data */
-	static int zswap[4] = { FALSE, FALSE, TRUE, TRUE };
-	static int rswap[4] = { FALSE, TRUE, FALSE, TRUE };
-	static integer ipivot[16] /* was [4][4] */  = { 1, 2, 3, 4, 2, 1, 4, 3, 3, 4, 1, 2,
+	static thread_local int zswap[4] = { FALSE, FALSE, TRUE, TRUE };
+	static thread_local int rswap[4] = { FALSE, TRUE, FALSE, TRUE };
+	static thread_local integer ipivot[16] /* was [4][4] */  = { 1, 2, 3, 4, 2, 1, 4, 3, 3, 4, 1, 2,
 	        4, 3, 2, 1
 	                                           };
 	/* System generated locals */
 	integer a_dim1, a_offset, b_dim1, b_offset, x_dim1, x_offset;
 	double d__1, d__2, d__3, d__4, d__5, d__6;
-	static double equiv_0[4], equiv_1[4];
+	static thread_local double equiv_0[4], equiv_1[4];
 
 	/* Local variables */
-	static double bbnd, cmax, ui11r, ui12s, temp, ur11r, ur12s;
-	static integer j;
-	static double u22abs;
-	static integer icmax;
-	static double bnorm, cnorm, smini;
+	static thread_local double bbnd, cmax, ui11r, ui12s, temp, ur11r, ur12s;
+	static thread_local integer j;
+	static thread_local double u22abs;
+	static thread_local integer icmax;
+	static thread_local double bnorm, cnorm, smini;
 
 #define ci (equiv_0)
 #define cr (equiv_1)
-	static double bignum, bi1, bi2, br1, br2, smlnum, xi1, xi2, xr1, xr2, ci21, ci22, cr21, cr22, li21, csi,
+	static thread_local double bignum, bi1, bi2, br1, br2, smlnum, xi1, xi2, xr1, xr2, ci21, ci22, cr21, cr22, li21, csi,
 	       ui11, lr21, ui12, ui22;
 #define civ (equiv_0)
-	static double csr, ur11, ur12, ur22;
+	static thread_local double csr, ur11, ur12, ur22;
 
 #define crv (equiv_1)
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -9752,17 +9754,17 @@ int NUMlapack_dlaln2 (int *ltrans, integer *na, integer *nw, double *smin, doubl
 
 double NUMlapack_dlange (const char *norm, integer *m, integer *n, double *a, integer *lda, double *work) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	static thread_local integer i__, j;
+	static thread_local double scale;
+	static thread_local double value;
+	static thread_local double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -9851,17 +9853,17 @@ double NUMlapack_dlange (const char *norm, integer *m, integer *n, double *a, in
 
 double NUMlapack_dlanhs (const char *norm, integer *n, double *a, integer *lda, double *work) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	static thread_local integer i__, j;
+	static thread_local double scale;
+	static thread_local double value;
+	static thread_local double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -9959,15 +9961,15 @@ double NUMlapack_dlanhs (const char *norm, integer *n, double *a, integer *lda,
 
 double NUMlapack_dlanst (const char *norm, integer *n, double *d__, double *e) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer i__1;
 	double ret_val, d__1, d__2, d__3, d__4, d__5;
-	static integer i__;
-	static double scale;
-	static double anorm;
-	static double sum;
+	static thread_local integer i__;
+	static thread_local double scale;
+	static thread_local double anorm;
+	static thread_local double sum;
 
 	--e;
 	--d__;
@@ -10031,18 +10033,18 @@ double NUMlapack_dlanst (const char *norm, integer *n, double *d__, double *e) {
 
 double NUMlapack_dlansy (const char *norm, const char *uplo, integer *n, double *a, integer *lda, double *work) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static double absa;
-	static integer i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	static thread_local double absa;
+	static thread_local integer i__, j;
+	static thread_local double scale;
+	static thread_local double value;
+	static thread_local double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -10163,15 +10165,15 @@ double NUMlapack_dlansy (const char *norm, const char *uplo, integer *n, double
 int NUMlapack_dlanv2 (double *a, double *b, double *c__, double *d__, double *rt1r, double *rt1i,
                       double *rt2r, double *rt2i, double *cs, double *sn) {
 	/* Table of constant values */
-	static double c_b4 = 1.;
+	static thread_local double c_b4 = 1.;
 
 	/* System generated locals */
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp, p, scale, bcmax, z__, bcmis, sigma;
-	static double aa, bb, cc, dd;
-	static double cs1, sn1, sab, sac, eps, tau;
+	static thread_local double temp, p, scale, bcmax, z__, bcmis, sigma;
+	static thread_local double aa, bb, cc, dd;
+	static thread_local double cs1, sn1, sab, sac, eps, tau;
 
 	eps = NUMblas_dlamch ("P");
 	if (*c__ == 0.) {
@@ -10314,9 +10316,9 @@ int NUMlapack_dlapll (integer *n, double *x, integer *incx, double *y, integer *
 	integer i__1;
 
 	/* Local variables */
-	static double c__;
-	static double ssmax, a11, a12, a22;
-	static double tau;
+	static thread_local double c__;
+	static thread_local double ssmax, a11, a12, a22;
+	static thread_local double tau;
 
 	--y;
 	--x;
@@ -10358,8 +10360,8 @@ int NUMlapack_dlapmt (integer *forwrd, integer *m, integer *n, double *x, intege
 	integer x_dim1, x_offset, i__1, i__2;
 
 	/* Local variables */
-	static double temp;
-	static integer i__, j, ii, in;
+	static thread_local double temp;
+	static thread_local integer i__, j, ii, in;
 
 	x_dim1 = *ldx;
 	x_offset = 1 + x_dim1 * 1;
@@ -10464,7 +10466,7 @@ double NUMlapack_dlapy2 (double *x, double *y) {
 	double ret_val, d__1;
 
 	/* Local variables */
-	static double xabs, yabs, w, z__;
+	static thread_local double xabs, yabs, w, z__;
 
 	xabs = fabs (*x);
 	yabs = fabs (*y);
@@ -10486,17 +10488,17 @@ double NUMlapack_dlapy2 (double *x, double *y) {
 int NUMlapack_dlarfb (const char *side, const char *trans, const char *direct, const char *storev, integer *m, integer *n, integer *k, double *v,
                       integer *ldv, double *t, integer *ldt, double *c__, integer *ldc, double *work, integer *ldwork) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static double c_b14 = 1.;
-	static double c_b25 = -1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b14 = 1.;
+	static thread_local double c_b25 = -1.;
 
 	/* System generated locals */
 	integer c_dim1, c_offset, t_dim1, t_offset, v_dim1, v_offset;
 	integer work_dim1, work_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer i__, j;
-	static char transt[1];
+	static thread_local integer i__, j;
+	static thread_local char transt[1];
 
 	v_dim1 = *ldv;
 	v_offset = 1 + v_dim1 * 1;
@@ -11045,9 +11047,9 @@ int NUMlapack_dlarfb (const char *side, const char *trans, const char *direct, c
 int NUMlapack_dlarf (const char *side, integer *m, integer *n, double *v, integer *incv, double *tau, double *c__, integer *ldc,
                      double *work) {
 	/* Table of constant values */
-	static double c_b4 = 1.;
-	static double c_b5 = 0.;
-	static integer c__1 = 1;
+	static thread_local double c_b4 = 1.;
+	static thread_local double c_b5 = 0.;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer c_dim1, c_offset;
@@ -11102,11 +11104,11 @@ int NUMlapack_dlarfg (integer *n, double *alpha, double *x, integer *incx, doubl
 	double d__1;
 
 	/* Local variables */
-	static double beta;
-	static integer j;
-	static double xnorm;
-	static double safmin, rsafmn;
-	static integer knt;
+	static thread_local double beta;
+	static thread_local integer j;
+	static thread_local double xnorm;
+	static thread_local double safmin, rsafmn;
+	static thread_local integer knt;
 
 	--x;
 
@@ -11184,16 +11186,16 @@ L10:
 int NUMlapack_dlarft (const char *direct, const char *storev, integer *n, integer *k, double *v, integer *ldv, double *tau,
                       double *t, integer *ldt) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static double c_b8 = 0.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b8 = 0.;
 
 	/* System generated locals */
 	integer t_dim1, t_offset, v_dim1, v_offset, i__1, i__2, i__3;
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j;
-	static double vii;
+	static thread_local integer i__, j;
+	static thread_local double vii;
 
 	v_dim1 = *ldv;
 	v_offset = 1 + v_dim1 * 1;
@@ -11319,18 +11321,18 @@ int NUMlapack_dlarft (const char *direct, const char *storev, integer *n, intege
 
 int NUMlapack_dlartg (double *f, double *g, double *cs, double *sn, double *r__) {
 	/* Initialized data */
-	static integer first = TRUE;
+	static thread_local integer first = TRUE;
 
 	/* System generated locals */
 	integer i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static integer i__;
-	static double scale;
-	static integer count;
-	static double f1, g1, safmn2, safmx2;
-	static double safmin, eps;
+	static thread_local integer i__;
+	static thread_local double scale;
+	static thread_local integer count;
+	static thread_local double f1, g1, safmn2, safmx2;
+	static thread_local double safmin, eps;
 
 	if (first) {
 		first = FALSE;
@@ -11424,17 +11426,17 @@ L30:
 int NUMlapack_dlarfx (const char *side, integer *m, integer *n, double *v, double *tau, double *c__, integer *ldc,
                       double *work) {
 	/* Table of constant values */
-	static double c_b14 = 1.;
-	static integer c__1 = 1;
-	static double c_b16 = 0.;
+	static thread_local double c_b14 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b16 = 0.;
 
 	/* System generated locals */
 	integer c_dim1, c_offset, i__1;
 	double d__1;
 
 	/* Local variables */
-	static integer j;
-	static double t1, t2, t3, t4, t5, t6, t7, t8, t9, v1, v2, v3, v4, v5, v6, v7, v8, v9, t10, v10, sum;
+	static thread_local integer j;
+	static thread_local double t1, t2, t3, t4, t5, t6, t7, t8, t9, v1, v2, v3, v4, v5, v6, v7, v8, v9, t10, v10, sum;
 
 	--v;
 	c_dim1 = *ldc;
@@ -12089,7 +12091,7 @@ int NUMlapack_dlas2 (double *f, double *g, double *h__, double *ssmin, double *s
 	double d__1, d__2;
 
 	/* Local variables */
-	static double fhmn, fhmx, c__, fa, ga, ha, as, at, au;
+	static thread_local double fhmn, fhmx, c__, fa, ga, ha, as, at, au;
 
 	fa = fabs (*f);
 	ga = fabs (*g);
@@ -12148,13 +12150,13 @@ int NUMlapack_dlascl (const char *type__, integer *kl, integer *ku, double *cfro
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4, i__5;
 
 	/* Local variables */
-	static integer done;
-	static double ctoc;
-	static integer i__, j;
-	static integer itype, k1, k2, k3, k4;
-	static double cfrom1;
-	static double cfromc;
-	static double bignum, smlnum, mul, cto1;
+	static thread_local integer done;
+	static thread_local double ctoc;
+	static thread_local integer i__, j;
+	static thread_local integer itype, k1, k2, k3, k4;
+	static thread_local double cfrom1;
+	static thread_local double cfromc;
+	static thread_local double bignum, smlnum, mul, cto1;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -12374,7 +12376,7 @@ int NUMlapack_dlaset (const char *uplo, integer *m, integer *n, double *alpha, d
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j;
+	static thread_local integer i__, j;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -12445,13 +12447,13 @@ int NUMlapack_dlasq1 (integer *n, double *d__, double *e, double *work, integer
 	double d__1, d__2, d__3;
 
 	/* Local variables */
-	static integer i__;
-	static double scale;
-	static integer iinfo;
-	static double sigmn;
-	static double sigmx;
-	static double safmin;
-	static double eps;
+	static thread_local integer i__;
+	static thread_local double scale;
+	static thread_local integer iinfo;
+	static thread_local double sigmn;
+	static thread_local double sigmx;
+	static thread_local double safmin;
+	static thread_local double eps;
 
 	/* Parameter adjustments */
 	--work;
@@ -12550,23 +12552,23 @@ int NUMlapack_dlasq2 (integer *n, double *z__, integer *info) {
 	double d__1, d__2;
 
 	/* Local variables */
-	static integer ieee;
-	static integer nbig;
-	static double dmin__, emin, emax;
-	static integer ndiv, iter;
-	static double qmin, temp, qmax, zmax;
-	static integer splt;
-	static double d__, e;
-	static integer k;
-	static double s, t;
-	static integer nfail;
-	static double desig, trace, sigma;
-	static integer iinfo, i0, i4, n0;
-	static integer pp, iwhila, iwhilb;
-	static double oldemn, safmin;
-	static double eps, tol;
-	static integer ipn4;
-	static double tol2;
+	static thread_local integer ieee;
+	static thread_local integer nbig;
+	static thread_local double dmin__, emin, emax;
+	static thread_local integer ndiv, iter;
+	static thread_local double qmin, temp, qmax, zmax;
+	static thread_local integer splt;
+	static thread_local double d__, e;
+	static thread_local integer k;
+	static thread_local double s, t;
+	static thread_local integer nfail;
+	static thread_local double desig, trace, sigma;
+	static thread_local integer iinfo, i0, i4, n0;
+	static thread_local integer pp, iwhila, iwhilb;
+	static thread_local double oldemn, safmin;
+	static thread_local double eps, tol;
+	static thread_local integer ipn4;
+	static thread_local double tol2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -12968,25 +12970,25 @@ L150:
 int NUMlapack_dlasq3 (integer *i0, integer *n0, double *z__, integer *pp, double *dmin__, double *sigma, double *desig,
                       double *qmax, integer *nfail, integer *iter, integer *ndiv, integer *ieee) {
 	/* Initialized data */
-	static integer ttype = 0;
-	static double dmin1 = 0.;
-	static double dmin2 = 0.;
-	static double dn = 0.;
-	static double dn1 = 0.;
-	static double dn2 = 0.;
-	static double tau = 0.;
+	static thread_local integer ttype = 0;
+	static thread_local double dmin1 = 0.;
+	static thread_local double dmin2 = 0.;
+	static thread_local double dn = 0.;
+	static thread_local double dn1 = 0.;
+	static thread_local double dn2 = 0.;
+	static thread_local double tau = 0.;
 
 	/* System generated locals */
 	integer i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp, s, t;
-	static integer j4;
-	static integer nn;
-	static double safmin, eps, tol;
-	static integer n0in, ipn4;
-	static double tol2;
+	static thread_local double temp, s, t;
+	static thread_local integer j4;
+	static thread_local integer nn;
+	static thread_local double safmin, eps, tol;
+	static thread_local integer n0in, ipn4;
+	static thread_local double tol2;
 
 	--z__;
 
@@ -13205,16 +13207,16 @@ int NUMlapack_dlasq4 (integer *i0, integer *n0, double *z__, integer *pp, intege
                       double *dmin2, double *dn, double *dn1, double *dn2, double *tau, integer *ttype) {
 	/* Initialized data */
 
-	static double g = 0.;
+	static thread_local double g = 0.;
 
 	/* System generated locals */
 	integer i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double s, a2, b1, b2;
-	static integer i4, nn, np;
-	static double gam, gap1, gap2;
+	static thread_local double s, a2, b1, b2;
+	static thread_local integer i4, nn, np;
+	static thread_local double gam, gap1, gap2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -13513,8 +13515,8 @@ int NUMlapack_dlasq5 (integer *i0, integer *n0, double *z__, integer *pp, double
 	double d__1, d__2;
 
 	/* Local variables */
-	static double emin, temp, d__;
-	static integer j4, j4p2;
+	static thread_local double emin, temp, d__;
+	static thread_local integer j4, j4p2;
 
 	--z__;
 
@@ -13659,10 +13661,10 @@ int NUMlapack_dlasq6 (integer *i0, integer *n0, double *z__, integer *pp, double
 	double d__1, d__2;
 
 	/* Local variables */
-	static double emin, temp, d__;
-	static integer j4;
-	static double safmin;
-	static integer j4p2;
+	static thread_local double emin, temp, d__;
+	static thread_local integer j4;
+	static thread_local double safmin;
+	static thread_local integer j4p2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -13778,10 +13780,10 @@ int NUMlapack_dlasr (const char *side, const char *pivot, const char *direct, in
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer info;
-	static double temp;
-	static integer i__, j;
-	static double ctemp, stemp;
+	static thread_local integer info;
+	static thread_local double temp;
+	static thread_local integer i__, j;
+	static thread_local double ctemp, stemp;
 
 	--c__;
 	--s;
@@ -14034,12 +14036,12 @@ int NUMlapack_dlasrt (const char *id, integer *n, double *d__, integer *info) {
 	integer i__1, i__2;
 
 	/* Local variables */
-	static integer endd, i__, j;
-	static integer stack[64] /* was [2][32] */ ;
-	static double dmnmx, d1, d2, d3;
-	static integer start;
-	static integer stkpnt, dir;
-	static double tmp;
+	static thread_local integer endd, i__, j;
+	static thread_local integer stack[64] /* was [2][32] */ ;
+	static thread_local double dmnmx, d1, d2, d3;
+	static thread_local integer start;
+	static thread_local integer stkpnt, dir;
+	static thread_local double tmp;
 
 	--d__;
 
@@ -14243,8 +14245,8 @@ int NUMlapack_dlassq (integer *n, double *x, integer *incx, double *scale, doubl
 	double d__1;
 
 	/* Local variables */
-	static double absxi;
-	static integer ix;
+	static thread_local double absxi;
+	static thread_local integer ix;
 
 	--x;
 
@@ -14275,20 +14277,20 @@ int NUMlapack_dlassq (integer *n, double *x, integer *incx, double *scale, doubl
 int NUMlapack_dlasv2 (double *f, double *g, double *h__, double *ssmin, double *ssmax, double *snr, double *csr,
                       double *snl, double *csl) {
 	/* Table of constant values */
-	static double c_b3 = 2.;
-	static double c_b4 = 1.;
+	static thread_local double c_b3 = 2.;
+	static thread_local double c_b4 = 1.;
 
 	/* System generated locals */
 	double d__1;
 
 	/* Local variables */
-	static integer pmax;
-	static double temp;
-	static integer swap;
-	static double a, d__, l, m, r__, s, t, tsign, fa, ga, ha;
-	static double ft, gt, ht, mm;
-	static integer gasmal;
-	static double tt, clt, crt, slt, srt;
+	static thread_local integer pmax;
+	static thread_local double temp;
+	static thread_local integer swap;
+	static thread_local double a, d__, l, m, r__, s, t, tsign, fa, ga, ha;
+	static thread_local double ft, gt, ht, mm;
+	static thread_local integer gasmal;
+	static thread_local double tt, clt, crt, slt, srt;
 
 	ft = *f;
 	fa = fabs (ft);
@@ -14443,8 +14445,8 @@ int NUMlapack_dlaswp (integer *n, double *a, integer *lda, integer *k1, integer
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static double temp;
-	static integer i__, j, k, i1, i2, n32, ip, ix, ix0, inc;
+	static thread_local double temp;
+	static thread_local integer i__, j, k, i1, i2, n32, ip, ix, ix0, inc;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14518,18 +14520,18 @@ int NUMlapack_dlaswp (integer *n, double *a, integer *lda, integer *k1, integer
 int NUMlapack_dlatrd (const char *uplo, integer *n, integer *nb, double *a, integer *lda, double *e, double *tau, double *w,
                       integer *ldw) {
 	/* Table of constant values */
-	static double c_b5 = -1.;
-	static double c_b6 = 1.;
-	static integer c__1 = 1;
-	static double c_b16 = 0.;
+	static thread_local double c_b5 = -1.;
+	static thread_local double c_b6 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b16 = 0.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, w_dim1, w_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__;
-	static double alpha;
-	static integer iw;
+	static thread_local integer i__;
+	static thread_local double alpha;
+	static thread_local integer iw;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14677,15 +14679,15 @@ int NUMlapack_dlatrd (const char *uplo, integer *n, integer *nb, double *a, inte
 
 int NUMlapack_dorg2l (integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j, l;
-	static integer ii;
+	static thread_local integer i__, j, l;
+	static thread_local integer ii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14758,14 +14760,14 @@ int NUMlapack_dorg2l (integer *m, integer *n, integer *k, double *a, integer *ld
 
 int NUMlapack_dorg2r (integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j, l;
+	static thread_local integer i__, j, l;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14842,19 +14844,19 @@ int NUMlapack_dorg2r (integer *m, integer *n, integer *k, double *a, integer *ld
 int NUMlapack_dorgbr (const char *vect, integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work,
                       integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer iinfo;
-	static integer wantq;
-	static integer nb, mn;
-	static integer lwkopt;
-	static integer lquery;
+	static thread_local integer i__, j;
+	static thread_local integer iinfo;
+	static thread_local integer wantq;
+	static thread_local integer nb, mn;
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15001,16 +15003,16 @@ int NUMlapack_dorgbr (const char *vect, integer *m, integer *n, integer *k, doub
 int NUMlapack_dorghr (integer *n, integer *ilo, integer *ihi, double *a, integer *lda, double *tau, double *work,
                       integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer i__, j, iinfo, nb, nh;
-	static integer lwkopt;
-	static int lquery;
+	static thread_local integer i__, j, iinfo, nb, nh;
+	static thread_local integer lwkopt;
+	static thread_local int lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15117,7 +15119,7 @@ int NUMlapack_dorgl2 (integer *m, integer *n, integer *k, double *a, integer *ld
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j, l;
+	static thread_local integer i__, j, l;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15199,21 +15201,21 @@ int NUMlapack_dorgl2 (integer *m, integer *n, integer *k, double *a, integer *ld
 int NUMlapack_dorglq (integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j, l, nbmin, iinfo;
-	static integer ib, nb, ki, kk;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, j, l, nbmin, iinfo;
+	static thread_local integer ib, nb, ki, kk;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15369,21 +15371,21 @@ int NUMlapack_dorglq (integer *m, integer *n, integer *k, double *a, integer *ld
 int NUMlapack_dorgql (integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static integer i__, j, l, nbmin, iinfo;
-	static integer ib, nb, kk;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, j, l, nbmin, iinfo;
+	static thread_local integer ib, nb, kk;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15538,21 +15540,21 @@ int NUMlapack_dorgql (integer *m, integer *n, integer *k, double *a, integer *ld
 int NUMlapack_dorgqr (integer *m, integer *n, integer *k, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j, l, nbmin, iinfo;
-	static integer ib, nb, ki, kk;
-	static integer nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, j, l, nbmin, iinfo;
+	static thread_local integer ib, nb, ki, kk;
+	static thread_local integer nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15709,19 +15711,19 @@ int NUMlapack_dorgqr (integer *m, integer *n, integer *k, double *a, integer *ld
 int NUMlapack_dorgtr (const char *uplo, integer *n, double *a, integer *lda, double *tau, double *work, integer *lwork,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer iinfo;
-	static integer upper;
-	static integer nb;
-	static integer lwkopt;
-	static integer lquery;
+	static thread_local integer i__, j;
+	static thread_local integer iinfo;
+	static thread_local integer upper;
+	static thread_local integer nb;
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15852,17 +15854,17 @@ int NUMlapack_dorgtr (const char *uplo, integer *n, double *a, integer *lda, dou
 int NUMlapack_dorm2r (const char *side, const char *trans, integer *m, integer *n, integer *k, double *a, integer *lda, double *tau,
                       double *c__, integer *ldc, double *work, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer left;
-	static integer i__;
-	static integer i1, i2, i3, ic, jc, mi, ni, nq;
-	static integer notran;
-	static double aii;
+	static thread_local integer left;
+	static thread_local integer i__;
+	static thread_local integer i1, i2, i3, ic, jc, mi, ni, nq;
+	static thread_local integer notran;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15961,9 +15963,9 @@ int NUMlapack_dorm2r (const char *side, const char *trans, integer *m, integer *
 int NUMlapack_dormbr (const char *vect, const char *side, const char *trans, integer *m, integer *n, integer *k, double *a, integer *lda,
                       double *tau, double *c__, integer *ldc, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	const char *a__1[2];
@@ -15971,13 +15973,13 @@ int NUMlapack_dormbr (const char *vect, const char *side, const char *trans, int
 	char ch__1[2];
 
 	/* Local variables */
-	static integer left;
-	static integer iinfo, i1, i2, nb, mi, ni, nq, nw;
-	static integer notran;
-	static integer applyq;
-	static char transt[1];
-	static integer lwkopt;
-	static integer lquery;
+	static thread_local integer left;
+	static thread_local integer iinfo, i1, i2, nb, mi, ni, nq, nw;
+	static thread_local integer notran;
+	static thread_local integer applyq;
+	static thread_local char transt[1];
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16159,11 +16161,11 @@ int NUMlapack_dorml2 (const char *side, const char *trans, integer *m, integer *
 	integer a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer left;
-	static integer i__;
-	static integer i1, i2, i3, ic, jc, mi, ni, nq;
-	static integer notran;
-	static double aii;
+	static thread_local integer left;
+	static thread_local integer i__;
+	static thread_local integer i1, i2, i3, ic, jc, mi, ni, nq;
+	static thread_local integer notran;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16263,10 +16265,10 @@ int NUMlapack_dorml2 (const char *side, const char *trans, integer *m, integer *
 int NUMlapack_dormlq (const char *side, const char *trans, integer *m, integer *n, integer *k, double *a, integer *lda, double *tau,
                       double *c__, integer *ldc, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
-	static integer c__65 = 65;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
+	static thread_local integer c__65 = 65;
 
 	/* System generated locals */
 	char *a__1[2];
@@ -16274,18 +16276,18 @@ int NUMlapack_dormlq (const char *side, const char *trans, integer *m, integer *
 	char ch__1[2];
 
 	/* Local variables */
-	static integer left;
-	static integer i__;
-	static double t[4160] /* was [65][64] */ ;
-	static integer nbmin, iinfo, i1, i2, i3;
-	static integer ib, ic, jc, nb, mi, ni;
-	static integer nq, nw;
-	static integer notran;
-	static integer ldwork;
-	static char transt[1];
-	static integer lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer left;
+	static thread_local integer i__;
+	static thread_local double t[4160] /* was [65][64] */ ;
+	static thread_local integer nbmin, iinfo, i1, i2, i3;
+	static thread_local integer ib, ic, jc, nb, mi, ni;
+	static thread_local integer nq, nw;
+	static thread_local integer notran;
+	static thread_local integer ldwork;
+	static thread_local char transt[1];
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16450,10 +16452,10 @@ int NUMlapack_dormlq (const char *side, const char *trans, integer *m, integer *
 int NUMlapack_dormqr (const char *side, const char *trans, integer *m, integer *n, integer *k, double *a, integer *lda, double *tau,
                       double *c__, integer *ldc, double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
-	static integer c__65 = 65;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
+	static thread_local integer c__65 = 65;
 
 	/* System generated locals */
 	char *a__1[2];
@@ -16461,16 +16463,16 @@ int NUMlapack_dormqr (const char *side, const char *trans, integer *m, integer *
 	char ch__1[2];
 
 	/* Local variables */
-	static integer left;
-	static integer i__;
-	static double t[4160] /* was [65][64] */ ;
-	static integer nbmin, iinfo, i1, i2, i3;
-	static integer ib, ic, jc, nb, mi, ni;
-	static integer nq, nw;
-	static integer notran;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer left;
+	static thread_local integer i__;
+	static thread_local double t[4160] /* was [65][64] */ ;
+	static thread_local integer nbmin, iinfo, i1, i2, i3;
+	static thread_local integer ib, ic, jc, nb, mi, ni;
+	static thread_local integer nq, nw;
+	static thread_local integer notran;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16633,11 +16635,11 @@ int NUMlapack_dormr2 (const char *side, const char *trans, integer *m, integer *
 	integer a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer left;
-	static integer i__;
-	static integer i1, i2, i3, mi, ni, nq;
-	static integer notran;
-	static double aii;
+	static thread_local integer left;
+	static thread_local integer i__;
+	static thread_local integer i1, i2, i3, mi, ni, nq;
+	static thread_local integer notran;
+	static thread_local double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16731,17 +16733,17 @@ int NUMlapack_dormr2 (const char *side, const char *trans, integer *m, integer *
 
 int NUMlapack_dpotf2 (const char *uplo, integer *n, double *a, integer *lda, integer *info) {
 	/* Table of constant values */
-	static double c_b10 = -1.;
-	static double c_b12 = 1.;
+	static thread_local double c_b10 = -1.;
+	static thread_local double c_b12 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 	double d__1;
 
 	/* Local variables */
-	static integer j;
-	static int upper;
-	static double ajj;
+	static thread_local integer j;
+	static thread_local int upper;
+	static thread_local double ajj;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16842,10 +16844,10 @@ L40:
 }				/* NUMlapack_dpotf2_ */
 
 int NUMlapack_drscl (integer *n, double *sa, double *sx, integer *incx) {
-	static double cden;
-	static integer done;
-	static double cnum, cden1, cnum1;
-	static double bignum, smlnum, mul;
+	static thread_local double cden;
+	static thread_local integer done;
+	static thread_local double cnum, cden1, cnum1;
+	static thread_local double bignum, smlnum, mul;
 
 	--sx;
 
@@ -16906,36 +16908,36 @@ L10:
 int NUMlapack_dsteqr (const char *compz, integer *n, double *d__, double *e, double *z__, integer *ldz, double *work,
                       integer *info) {
 	/* Table of constant values */
-	static double c_b9 = 0.;
-	static double c_b10 = 1.;
-	static integer c__0 = 0;
-	static integer c__1 = 1;
-	static integer c__2 = 2;
+	static thread_local double c_b9 = 0.;
+	static thread_local double c_b10 = 1.;
+	static thread_local integer c__0 = 0;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c__2 = 2;
 
 	/* System generated locals */
 	integer z_dim1, z_offset, i__1, i__2;
 	double d__1, d__2;
 
 	/* Local variables */
-	static integer lend, jtot;
-	static double b, c__, f, g;
-	static integer i__, j, k, l, m;
-	static double p, r__, s;
-	static double anorm;
-	static integer l1;
-	static integer lendm1, lendp1;
-	static integer ii;
-	static integer mm, iscale;
-	static double safmin;
-	static double safmax;
-	static integer lendsv;
-	static double ssfmin;
-	static integer nmaxit, icompz;
-	static double ssfmax;
-	static integer lm1, mm1, nm1;
-	static double rt1, rt2, eps;
-	static integer lsv;
-	static double tst, eps2;
+	static thread_local integer lend, jtot;
+	static thread_local double b, c__, f, g;
+	static thread_local integer i__, j, k, l, m;
+	static thread_local double p, r__, s;
+	static thread_local double anorm;
+	static thread_local integer l1;
+	static thread_local integer lendm1, lendp1;
+	static thread_local integer ii;
+	static thread_local integer mm, iscale;
+	static thread_local double safmin;
+	static thread_local double safmax;
+	static thread_local integer lendsv;
+	static thread_local double ssfmin;
+	static thread_local integer nmaxit, icompz;
+	static thread_local double ssfmax;
+	static thread_local integer lm1, mm1, nm1;
+	static thread_local double rt1, rt2, eps;
+	static thread_local integer lsv;
+	static thread_local double tst, eps2;
 
 	--d__;
 	--e;
@@ -17383,31 +17385,31 @@ L190:
 
 int NUMlapack_dsterf (integer *n, double *d__, double *e, integer *info) {
 	/* Table of constant values */
-	static integer c__0 = 0;
-	static integer c__1 = 1;
-	static double c_b32 = 1.;
+	static thread_local integer c__0 = 0;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b32 = 1.;
 
 	/* System generated locals */
 	integer i__1;
 	double d__1, d__2, d__3;
 
 	/* Local variables */
-	static double oldc;
-	static integer lend, jtot;
-	static double c__;
-	static integer i__, l, m;
-	static double p, gamma, r__, s, alpha, sigma, anorm;
-	static integer l1;
-	static double bb;
-	static integer iscale;
-	static double oldgam, safmin;
-	static double safmax;
-	static integer lendsv;
-	static double ssfmin;
-	static integer nmaxit;
-	static double ssfmax, rt1, rt2, eps, rte;
-	static integer lsv;
-	static double eps2;
+	static thread_local double oldc;
+	static thread_local integer lend, jtot;
+	static thread_local double c__;
+	static thread_local integer i__, l, m;
+	static thread_local double p, gamma, r__, s, alpha, sigma, anorm;
+	static thread_local integer l1;
+	static thread_local double bb;
+	static thread_local integer iscale;
+	static thread_local double oldgam, safmin;
+	static thread_local double safmax;
+	static thread_local integer lendsv;
+	static thread_local double ssfmin;
+	static thread_local integer nmaxit;
+	static thread_local double ssfmax, rt1, rt2, eps, rte;
+	static thread_local integer lsv;
+	static thread_local double eps2;
 
 	--e;
 	--d__;
@@ -17749,35 +17751,35 @@ L180:
 int NUMlapack_dsyev (const char *jobz, const char *uplo, integer *n, double *a, integer *lda, double *w, double *work,
                      integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__0 = 0;
-	static double c_b17 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__0 = 0;
+	static thread_local double c_b17 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 	double d__1;
 
 	/* Local variables */
-	static integer inde;
-	static double anrm;
-	static integer imax;
-	static double rmin, rmax;
-	static integer lopt;
-	static double sigma;
-	static integer iinfo;
-	static integer lower, wantz;
-	static integer nb;
-	static integer iscale;
-	static double safmin;
-	static double bignum;
-	static integer indtau;
-	static integer indwrk;
-	static integer llwork;
-	static double smlnum;
-	static integer lwkopt;
-	static integer lquery;
-	static double eps;
+	static thread_local integer inde;
+	static thread_local double anrm;
+	static thread_local integer imax;
+	static thread_local double rmin, rmax;
+	static thread_local integer lopt;
+	static thread_local double sigma;
+	static thread_local integer iinfo;
+	static thread_local integer lower, wantz;
+	static thread_local integer nb;
+	static thread_local integer iscale;
+	static thread_local double safmin;
+	static thread_local double bignum;
+	static thread_local integer indtau;
+	static thread_local integer indwrk;
+	static thread_local integer llwork;
+	static thread_local double smlnum;
+	static thread_local integer lwkopt;
+	static thread_local integer lquery;
+	static thread_local double eps;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -17905,18 +17907,18 @@ int NUMlapack_dsyev (const char *jobz, const char *uplo, integer *n, double *a,
 int NUMlapack_dsytd2 (const char *uplo, integer *n, double *a, integer *lda, double *d__, double *e, double *tau,
                       integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static double c_b8 = 0.;
-	static double c_b14 = -1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b8 = 0.;
+	static thread_local double c_b14 = -1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static double taui;
-	static integer i__;
-	static double alpha;
-	static integer upper;
+	static thread_local double taui;
+	static thread_local integer i__;
+	static thread_local double alpha;
+	static thread_local integer upper;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18044,24 +18046,24 @@ int NUMlapack_dsytd2 (const char *uplo, integer *n, double *a, integer *lda, dou
 int NUMlapack_dsytrd (const char *uplo, integer *n, double *a, integer *lda, double *d__, double *e, double *tau,
                       double *work, integer *lwork, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__3 = 3;
-	static integer c__2 = 2;
-	static double c_b22 = -1.;
-	static double c_b23 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__3 = 3;
+	static thread_local integer c__2 = 2;
+	static thread_local double c_b22 = -1.;
+	static thread_local double c_b23 = 1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static integer i__, j;
-	static integer nbmin, iinfo;
-	static integer upper;
-	static integer nb, kk, nx;
-	static integer ldwork, lwkopt;
-	static integer lquery;
-	static integer iws;
+	static thread_local integer i__, j;
+	static thread_local integer nbmin, iinfo;
+	static thread_local integer upper;
+	static thread_local integer nb, kk, nx;
+	static thread_local integer ldwork, lwkopt;
+	static thread_local integer lquery;
+	static thread_local integer iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18238,10 +18240,10 @@ int NUMlapack_dtgsja (const char *jobu, const char *jobv, const char *jobq, inte
                       double *a, integer *lda, double *b, integer *ldb, double *tola, double *tolb, double *alpha, double *beta,
                       double *u, integer *ldu, double *v, integer *ldv, double *q, integer *ldq, double *work, integer *ncycle, integer *info) {
 	/* Table of constant values */
-	static double c_b13 = 0.;
-	static double c_b14 = 1.;
-	static integer c__1 = 1;
-	static double c_b43 = -1.;
+	static thread_local double c_b13 = 0.;
+	static thread_local double c_b14 = 1.;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b43 = -1.;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, b_dim1, b_offset, q_dim1, q_offset, u_dim1, u_offset, v_dim1, v_offset, i__1, i__2,
@@ -18249,17 +18251,17 @@ int NUMlapack_dtgsja (const char *jobu, const char *jobv, const char *jobq, inte
 	double d__1;
 
 	/* Local variables */
-	static integer i__, j;
-	static double gamma;
-	static double a1;
-	static integer initq;
-	static double a2, a3, b1;
-	static integer initu, initv, wantq, upper;
-	static double b2, b3;
-	static integer wantu, wantv;
-	static double error, ssmin;
-	static integer kcycle;
-	static double csq, csu, csv, snq, rwk, snu, snv;
+	static thread_local integer i__, j;
+	static thread_local double gamma;
+	static thread_local double a1;
+	static thread_local integer initq;
+	static thread_local double a2, a3, b1;
+	static thread_local integer initu, initv, wantq, upper;
+	static thread_local double b2, b3;
+	static thread_local integer wantu, wantv;
+	static thread_local double error, ssmin;
+	static thread_local integer kcycle;
+	static thread_local double csq, csu, csv, snq, rwk, snu, snv;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18555,40 +18557,40 @@ L100:
 int NUMlapack_dtrevc (const char *side, const char *howmny, int *select, integer *n, double *t, integer *ldt, double *vl,
                       integer *ldvl, double *vr, integer *ldvr, integer *mm, integer *m, double *work, integer *info) {
 	/* Table of constant values */
-	static int c_false = FALSE;
-	static integer c__1 = 1;
-	static double c_b22 = 1.;
-	static double c_b25 = 0.;
-	static integer c__2 = 2;
-	static int c_true = TRUE;
+	static thread_local int c_false = FALSE;
+	static thread_local integer c__1 = 1;
+	static thread_local double c_b22 = 1.;
+	static thread_local double c_b25 = 0.;
+	static thread_local integer c__2 = 2;
+	static thread_local int c_true = TRUE;
 
 	/* System generated locals */
 	integer t_dim1, t_offset, vl_dim1, vl_offset, vr_dim1, vr_offset, i__1, i__2, i__3;
 	double d__1, d__2, d__3, d__4, d__5, d__6;
 
 	/* Local variables */
-	static double beta, emax;
-	static int pair;
-	static int allv;
-	static integer ierr;
-	static double unfl, ovfl, smin;
-	static int over;
-	static double vmax;
-	static integer jnxt, i__, j, k;
-	static double scale, x[4] /* was [2][2] */ ;
-	static double remax;
-	static int leftv, bothv;
-	static double vcrit;
-	static int somev;
-	static integer j1, j2, n2;
-	static double xnorm;
-	static integer ii, ki;
-	static integer ip, is;
-	static double wi;
-	static double wr;
-	static double bignum;
-	static int rightv;
-	static double smlnum, rec, ulp;
+	static thread_local double beta, emax;
+	static thread_local int pair;
+	static thread_local int allv;
+	static thread_local integer ierr;
+	static thread_local double unfl, ovfl, smin;
+	static thread_local int over;
+	static thread_local double vmax;
+	static thread_local integer jnxt, i__, j, k;
+	static thread_local double scale, x[4] /* was [2][2] */ ;
+	static thread_local double remax;
+	static thread_local int leftv, bothv;
+	static thread_local double vcrit;
+	static thread_local int somev;
+	static thread_local integer j1, j2, n2;
+	static thread_local double xnorm;
+	static thread_local integer ii, ki;
+	static thread_local integer ip, is;
+	static thread_local double wi;
+	static thread_local double wr;
+	static thread_local double bignum;
+	static thread_local int rightv;
+	static thread_local double smlnum, rec, ulp;
 
 #define t_ref(a_1,a_2) t[(a_2)*t_dim1 + a_1]
 #define x_ref(a_1,a_2) x[(a_2)*2 + a_1 - 3]
@@ -19537,16 +19539,16 @@ L250:
 
 int NUMlapack_dtrti2 (const char *uplo, const char *diag, integer *n, double *a, integer *lda, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static integer j;
-	static integer upper;
-	static integer nounit;
-	static double ajj;
+	static thread_local integer j;
+	static thread_local integer upper;
+	static thread_local integer nounit;
+	static thread_local double ajj;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -19622,11 +19624,11 @@ int NUMlapack_dtrti2 (const char *uplo, const char *diag, integer *n, double *a,
 
 int NUMlapack_dtrtri (const char *uplo, const char *diag, integer *n, double *a, integer *lda, integer *info) {
 	/* Table of constant values */
-	static integer c__1 = 1;
-	static integer c_n1 = -1;
-	static integer c__2 = 2;
-	static double c_b18 = 1.;
-	static double c_b22 = -1.;
+	static thread_local integer c__1 = 1;
+	static thread_local integer c_n1 = -1;
+	static thread_local integer c__2 = 2;
+	static thread_local double c_b18 = 1.;
+	static thread_local double c_b22 = -1.;
 
 	/* System generated locals */
 	char *a__1[2];
@@ -19634,10 +19636,10 @@ int NUMlapack_dtrtri (const char *uplo, const char *diag, integer *n, double *a,
 	char ch__1[2];
 
 	/* Local variables */
-	static integer j;
-	static integer upper;
-	static integer jb, nb, nn;
-	static integer nounit;
+	static thread_local integer j;
+	static thread_local integer upper;
+	static thread_local integer jb, nb, nn;
+	static thread_local integer nounit;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -19759,7 +19761,7 @@ integer NUMlapack_ieeeck (integer *ispec, float *zero, float *one) {
 	integer ret_val;
 
 	/* Local variables */
-	static float neginf, posinf, negzro, newzro, nan1, nan2, nan3, nan4, nan5, nan6;
+	static thread_local float neginf, posinf, negzro, newzro, nan1, nan2, nan3, nan4, nan5, nan6;
 
 	ret_val = 1;
 
@@ -19865,22 +19867,22 @@ integer NUMlapack_ieeeck (integer *ispec, float *zero, float *one) {
 integer NUMlapack_ilaenv (integer *ispec, const char *name__, const char *opts, integer *n1, integer *n2, integer *n3, integer *n4,
                        integer name_len, integer opts_len) {
 	/* Table of constant values */
-	static integer c__0 = 0;
-	static float c_b162 = 0.f;
-	static float c_b163 = 1.f;
-	static integer c__1 = 1;
+	static thread_local integer c__0 = 0;
+	static thread_local float c_b162 = 0.f;
+	static thread_local float c_b163 = 1.f;
+	static thread_local integer c__1 = 1;
 
 	/* System generated locals */
 	integer ret_val;
 
 	/* Local variables */
-	static integer i__;
-	static integer cname, sname;
-	static integer nbmin;
-	static char c1[1], c2[2], c3[3], c4[2];
-	static integer ic, nb;
-	static integer iz, nx;
-	static char subnam[6];
+	static thread_local integer i__;
+	static thread_local integer cname, sname;
+	static thread_local integer nbmin;
+	static thread_local char c1[1], c2[2], c3[3], c4[2];
+	static thread_local integer ic, nb;
+	static thread_local integer iz, nx;
+	static thread_local char subnam[6];
 
 	(void) opts;
 	(void) n3;
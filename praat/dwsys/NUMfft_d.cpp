@@ -22,8 +22,16 @@
  */
 
 #include "NUM2.h"
+#include "NUMfft_vectorized.h"
 #include "melder.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #define FFT_DATA_TYPE double
 #include "NUMfft_core.h"
 
@@ -58,25 +66,353 @@ void NUMreverseRealFastFourierTransform (double *data, integer n) {
 	NUMfft_backward (& table, data);
 }
 
+/*
+	FFTPACK has special passes for the factors 2, 3, 4, and 5 of n, and a general pass for any other factor p,
+	which takes time proportional to n p. For n with a large prime factor (in the extreme, a prime n), this is slow,
+	so such transforms are computed as a convolution with a chirp, of a size that is a power of two (Bluestein's algorithm):
+	with w [j] = exp (pi i j^2 / n), and jk = (j^2 + k^2 - (k - j)^2) / 2,
+	X [k] = sum_j x [j] exp (-2 pi i jk / n) = conj (w [k]) sum_j (x [j] conj (w [j])) w [k - j].
+*/
+enum class NUMfft_Backend { FFTPACK, VECTORIZED, BLUESTEIN };
+
+/*
+	The trigonometric tables of one transform size and backend. Computing them takes longer than a transform itself,
+	so every NUMfft_Table of that size borrows the same plan, from a process-wide cache: the frames of an analysis,
+	the threads that analyse them, and the next analysis with the same frame length all share the tables.
+	A plan is never changed after it has been made.
+*/
+struct structNUMfft_Plan {
+	integer n;
+	NUMfft_Backend backend;
+	structNUMfft_VectorizedPlan *vectorizedPlan;   // if VECTORIZED, of size n; if BLUESTEIN, of size 2 * numberOfConvolutionPoints
+	std::vector <double> fftpackFactors;   // FFTPACK's wa [0..2n-1], if FFTPACK
+	integer fftpackSplit [32];   // FFTPACK's ifac
+	integer numberOfConvolutionPoints;   // if BLUESTEIN: a power of two of at least 2n - 1
+	std::vector <double> chirpCos, chirpSin;   // if BLUESTEIN: w [j], for j = 0 .. n - 1
+	std::vector <double> chirpSpectrumRe, chirpSpectrumIm;   // if BLUESTEIN: the transform of w, divided by numberOfConvolutionPoints
+	bool permanent;
+	integer numberOfUsers;   // of a plan that is not permanent, including the cache; guarded by the mutex of the cache
+	~structNUMfft_Plan () {
+		if (vectorizedPlan)
+			NUMfft_VectorizedPlan_delete (vectorizedPlan);
+	}
+};
+
+static void NUMfft_Plan_initBluestein (structNUMfft_Plan *me) {
+	const integer n = my n;
+	integer m = 2;
+	while (m < 2 * n - 1)
+		m *= 2;
+	my numberOfConvolutionPoints = m;
+	my vectorizedPlan = NUMfft_VectorizedPlan_create (2 * m);
+
+	my chirpCos.resize ((size_t) n);
+	my chirpSin.resize ((size_t) n);
+	for (integer j = 0; j < n; j ++) {
+		const integer jSquaredModulo2n = (integer) ((uint64) j * (uint64) j % (uint64) (2 * n));   // exact, so that the phase stays accurate for large j
+		const double phase = NUMpi * double (jSquaredModulo2n) / n;
+		my chirpCos [(size_t) j] = cos (phase);
+		my chirpSin [(size_t) j] = sin (phase);
+	}
+
+	/*
+		The chirp is needed at k - j, for k and j from 0 to n - 1, i.e. at -(n - 1) .. n - 1, which wraps around in the circular convolution.
+	*/
+	my chirpSpectrumRe.assign ((size_t) m, 0.0);
+	my chirpSpectrumIm.assign ((size_t) m, 0.0);
+	for (integer j = 0; j < n; j ++) {
+		my chirpSpectrumRe [(size_t) j] = my chirpCos [(size_t) j];
+		my chirpSpectrumIm [(size_t) j] = my chirpSin [(size_t) j];
+		if (j > 0) {
+			my chirpSpectrumRe [(size_t) (m - j)] = my chirpCos [(size_t) j];
+			my chirpSpectrumIm [(size_t) (m - j)] = my chirpSin [(size_t) j];
+		}
+	}
+	std::vector <double> workspace ((size_t) (2 * m));
+	NUMfft_VectorizedPlan_complexForward (my vectorizedPlan, my chirpSpectrumRe.data (), my chirpSpectrumIm.data (), workspace.data ());
+	for (integer k = 0; k < m; k ++) {
+		my chirpSpectrumRe [(size_t) k] /= m;
+		my chirpSpectrumIm [(size_t) k] /= m;
+	}
+}
+
+static structNUMfft_Plan *NUMfft_Plan_create (integer n, NUMfft_Backend backend) {
+	auto me = std::make_unique <structNUMfft_Plan> ();
+	my n = n;
+	my backend = backend;
+	my vectorizedPlan = nullptr;
+	my numberOfConvolutionPoints = 0;
+	if (backend == NUMfft_Backend::VECTORIZED) {
+		my vectorizedPlan = NUMfft_VectorizedPlan_create (n);
+	} else if (backend == NUMfft_Backend::BLUESTEIN) {
+		NUMfft_Plan_initBluestein (me.get ());
+	} else {
+		my fftpackFactors.assign ((size_t) (2 * n), 0.0);
+		std::fill (my fftpackSplit, my fftpackSplit + 32, 0);
+		if (n > 1)
+			drfti1 (n, my fftpackFactors.data (), my fftpackSplit);
+	}
+	my permanent = false;
+	my numberOfUsers = 0;
+	return me.release ();
+}
+
+static integer NUMfft_Plan_getSize (const structNUMfft_Plan *me) {
+	if (my backend == NUMfft_Backend::VECTORIZED)
+		return NUMfft_VectorizedPlan_getSize (my vectorizedPlan);
+	if (my backend == NUMfft_Backend::BLUESTEIN)
+		return NUMfft_VectorizedPlan_getSize (my vectorizedPlan) + (integer) (sizeof (structNUMfft_Plan) + sizeof (double) *
+			(my chirpCos.size () + my chirpSin.size () + my chirpSpectrumRe.size () + my chirpSpectrumIm.size ()));
+	return (integer) (sizeof (structNUMfft_Plan) + sizeof (double) * my fftpackFactors.size ());
+}
+
+static integer NUMfft_Plan_getWorkspaceSize (const structNUMfft_Plan *me) {
+	switch (my backend) {
+		case NUMfft_Backend::VECTORIZED: return 2 * my n;
+		case NUMfft_Backend::BLUESTEIN: return 4 * my numberOfConvolutionPoints;
+		default: return my n;
+	}
+}
+
+/*
+	The transform of the complex sequence re [0..n-1] + i im [0..n-1], in place;
+	re and im are the first two quarters of the workspace of the table, of which the last half is the workspace of the convolution.
+*/
+static void NUMfft_Plan_bluestein (const structNUMfft_Plan *me, double *re, double *im, double *workspace) {
+	const integer n = my n, m = my numberOfConvolutionPoints;
+	const double *c = my chirpCos.data (), *s = my chirpSin.data ();
+	for (integer j = 0; j < n; j ++) {   // times conj (w [j])
+		const double xr = re [j], xi = im [j];
+		re [j] = xr * c [j] + xi * s [j];
+		im [j] = xi * c [j] - xr * s [j];
+	}
+	std::fill (re + n, re + m, 0.0);
+	std::fill (im + n, im + m, 0.0);
+	NUMfft_VectorizedPlan_complexForward (my vectorizedPlan, re, im, workspace);
+	/*
+		Multiply by the transform of the chirp, and transform back, as the conjugate of the forward transform of the conjugate.
+	*/
+	const double *wr = my chirpSpectrumRe.data (), *wi = my chirpSpectrumIm.data ();
+	for (integer k = 0; k < m; k ++) {
+		const double ar = re [k], ai = im [k];
+		re [k] = ar * wr [k] - ai * wi [k];
+		im [k] = - (ar * wi [k] + ai * wr [k]);
+	}
+	NUMfft_VectorizedPlan_complexForward (my vectorizedPlan, re, im, workspace);
+	for (integer k = 0; k < n; k ++) {   // times conj (w [k]), after undoing the conjugation
+		const double yr = re [k], yi = - im [k];
+		re [k] = yr * c [k] + yi * s [k];
+		im [k] = yi * c [k] - yr * s [k];
+	}
+}
+
+/*
+	The plans of powers of two up to 2^20 (at most 16 megabytes each, for the vectorized FFT) are kept for the whole session,
+	because those are the sizes of analysis frames. Of the other sizes, which are typically those of whole sounds,
+	only the few most recently used plans are kept, so that their tables do not stay in memory.
+*/
+struct NUMfft_PlanCache {
+	std::mutex mutex;
+	std::map <std::pair <integer, NUMfft_Backend>, structNUMfft_Plan *> permanentPlans;
+	std::vector <structNUMfft_Plan *> recentPlans;   // least recently used first
+	integer numberOfHits = 0, numberOfMisses = 0;
+};
+
+static NUMfft_PlanCache& thePlanCache () {
+	static auto *cache = new NUMfft_PlanCache;   // never destroyed: tables on other threads may still use its plans while the process exits
+	return *cache;
+}
+
+static void NUMfft_Plan_releaseWithLock (structNUMfft_Plan *me) {
+	if (-- my numberOfUsers == 0)
+		delete me;
+}
+
+static const structNUMfft_Plan *NUMfft_Plan_get (integer n, NUMfft_Backend backend) {
+	constexpr integer maximumPermanentSize = 1 << 20, maximumNumberOfRecentPlans = 8;
+	NUMfft_PlanCache& cache = thePlanCache ();
+	std::lock_guard <std::mutex> lock (cache.mutex);
+	if (n <= maximumPermanentSize && (n & (n - 1)) == 0) {
+		structNUMfft_Plan*& plan = cache.permanentPlans [std::make_pair (n, backend)];
+		if (plan) {
+			cache.numberOfHits += 1;
+		} else {
+			cache.numberOfMisses += 1;
+			plan = NUMfft_Plan_create (n, backend);
+			plan -> permanent = true;
+		}
+		return plan;
+	}
+	auto found = std::find_if (cache.recentPlans.begin (), cache.recentPlans.end (),
+		[&] (structNUMfft_Plan *plan) { return plan -> n == n && plan -> backend == backend; });
+	structNUMfft_Plan *plan;
+	if (found != cache.recentPlans.end ()) {
+		cache.numberOfHits += 1;
+		plan = *found;
+		cache.recentPlans.erase (found);
+	} else {
+		cache.numberOfMisses += 1;
+		plan = NUMfft_Plan_create (n, backend);
+		plan -> numberOfUsers = 1;   // the cache
+		if ((integer) cache.recentPlans.size () >= maximumNumberOfRecentPlans) {
+			NUMfft_Plan_releaseWithLock (cache.recentPlans.front ());
+			cache.recentPlans.erase (cache.recentPlans.begin ());
+		}
+	}
+	cache.recentPlans.push_back (plan);
+	plan -> numberOfUsers += 1;
+	return plan;
+}
+
+static void NUMfft_Plan_release (const structNUMfft_Plan *me) {
+	if (! me || my permanent)
+		return;
+	std::lock_guard <std::mutex> lock (thePlanCache (). mutex);
+	NUMfft_Plan_releaseWithLock (const_cast <structNUMfft_Plan *> (me));
+}
+
+void NUMfft_getPlanCacheStatistics (integer *numberOfHits, integer *numberOfMisses, integer *numberOfPlans, integer *numberOfBytes) {
+	NUMfft_PlanCache& cache = thePlanCache ();
+	std::lock_guard <std::mutex> lock (cache.mutex);
+	if (numberOfHits)
+		*numberOfHits = cache.numberOfHits;
+	if (numberOfMisses)
+		*numberOfMisses = cache.numberOfMisses;
+	if (numberOfPlans)
+		*numberOfPlans = (integer) (cache.permanentPlans.size () + cache.recentPlans.size ());
+	if (numberOfBytes) {
+		integer size = 0;
+		for (const auto& entry : cache.permanentPlans)
+			size += NUMfft_Plan_getSize (entry.second);
+		for (const structNUMfft_Plan *plan : cache.recentPlans)
+			size += NUMfft_Plan_getSize (plan);
+		*numberOfBytes = size;
+	}
+}
+
 void NUMfft_forward (NUMfft_Table me, double *data) {
 	if (my n == 1) {
 		return;
 	}
-	drftf1 (my n, &data[1], my trigcache, my trigcache + my n, my splitcache);
+	if (my plan -> backend == NUMfft_Backend::VECTORIZED) {
+		NUMfft_VectorizedPlan_forward (my plan -> vectorizedPlan, data, my workspace);
+		return;
+	}
+	if (my plan -> backend == NUMfft_Backend::BLUESTEIN) {
+		const integer n = my n, m = my plan -> numberOfConvolutionPoints;
+		double *re = my workspace, *im = my workspace + m;
+		for (integer j = 0; j < n; j ++) {
+			re [j] = data [j + 1];
+			im [j] = 0.0;
+		}
+		NUMfft_Plan_bluestein (my plan, re, im, my workspace + 2 * m);
+		data [1] = re [0];
+		for (integer k = 1; 2 * k < n; k ++) {
+			data [2 * k] = re [k];
+			data [2 * k + 1] = im [k];
+		}
+		if (n % 2 == 0)
+			data [n] = re [n / 2];
+		return;
+	}
+	/*
+		FFTPACK only reads its factors, so the tables of the plan can be shared.
+	*/
+	drftf1 (my n, &data[1], my workspace, const_cast <double *> (my plan -> fftpackFactors.data ()), const_cast <integer *> (my plan -> fftpackSplit));
 }
 
 void NUMfft_backward (NUMfft_Table me, double *data) {
 	if (my n == 1) {
 		return;
 	}
-	drftb1 (my n, &data[1], my trigcache, my trigcache + my n, my splitcache);
+	if (my plan -> backend == NUMfft_Backend::VECTORIZED) {
+		NUMfft_VectorizedPlan_backward (my plan -> vectorizedPlan, data, my workspace);
+		return;
+	}
+	if (my plan -> backend == NUMfft_Backend::BLUESTEIN) {
+		/*
+			The real result is the real part of the forward transform of the conjugate of the whole (Hermitian) spectrum.
+		*/
+		const integer n = my n, m = my plan -> numberOfConvolutionPoints;
+		double *re = my workspace, *im = my workspace + m;
+		re [0] = data [1];
+		im [0] = 0.0;
+		for (integer k = 1; 2 * k < n; k ++) {
+			re [k] = re [n - k] = data [2 * k];
+			im [k] = - data [2 * k + 1];
+			im [n - k] = data [2 * k + 1];
+		}
+		if (n % 2 == 0) {
+			re [n / 2] = data [n];
+			im [n / 2] = 0.0;
+		}
+		NUMfft_Plan_bluestein (my plan, re, im, my workspace + 2 * m);
+		for (integer j = 0; j < n; j ++)
+			data [j + 1] = re [j];
+		return;
+	}
+	drftb1 (my n, &data[1], my workspace, const_cast <double *> (my plan -> fftpackFactors.data ()), const_cast <integer *> (my plan -> fftpackSplit));
+}
+
+/*
+	Each pass of FFTPACK, for a factor p of n, takes time proportional to n p;
+	Bluestein's algorithm takes two complex transforms of size m (a power of two of at least 2n - 1), i.e. time proportional to m log2 m,
+	but with a constant that is about ten times as large (measured for n from 1000 to 1000000).
+*/
+static bool NUMfft_isFasterWithBluestein (integer n) {
+	double fftpackCost = 0.0;
+	integer remainder = n;
+	for (integer factor = 2; factor * factor <= remainder; factor ++) {
+		while (remainder % factor == 0) {
+			fftpackCost += double (n) * factor;
+			remainder /= factor;
+		}
+	}
+	if (remainder > 1)
+		fftpackCost += double (n) * remainder;
+	integer m = 2, log2m = 1;
+	while (m < 2 * n - 1) {
+		m *= 2;
+		log2m += 1;
+	}
+	const double bluesteinCost = 10.0 * double (m) * log2m;
+	return fftpackCost > bluesteinCost;
 }
 
 void NUMfft_Table_init (NUMfft_Table me, integer n) {
+	constexpr integer minimumVectorizedSize = 64;   // below this, FFTPACK is as fast
+	NUMfft_Backend backend = NUMfft_Backend::FFTPACK;
+	if (Melder_debug != 52) {
+		if (n >= minimumVectorizedSize && (n & (n - 1)) == 0)
+			backend = NUMfft_Backend::VECTORIZED;
+		else if (n >= minimumVectorizedSize && NUMfft_isFasterWithBluestein (n))
+			backend = NUMfft_Backend::BLUESTEIN;
+	}
 	my n = n;
-	my trigcache = NUMvector <double> (0, 3 * n - 1);
-	my splitcache = NUMvector <integer> (0, 31);
-	NUMrffti (n, my trigcache, my splitcache);
+	my plan = NUMfft_Plan_get (n, backend);
+	my workspace = NUMvector <double> (0, NUMfft_Plan_getWorkspaceSize (my plan) - 1);
+}
+
+integer NUMfft_getFastSize (integer n) {
+	integer fastSize = 1;
+	while (fastSize < n)
+		fastSize *= 2;
+	for (integer power7 = 1; power7 < fastSize; power7 *= 7)
+		for (integer power75 = power7; power75 < fastSize; power75 *= 5)
+			for (integer power753 = power75; power753 < fastSize; power753 *= 3) {
+				integer size = power753;
+				while (size < n)
+					size *= 2;
+				fastSize = std::min (fastSize, size);
+			}
+	return fastSize;
+}
+
+void NUMfft_Table_free (NUMfft_Table me) {
+	NUMvector_free (my workspace, 0);
+	NUMfft_Plan_release (my plan);
+	my workspace = nullptr;
+	my plan = nullptr;
 }
 
 void NUMrealft (double *data, integer n, int isign) {
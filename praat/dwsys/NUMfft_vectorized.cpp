@@ -0,0 +1,330 @@
+/* NUMfft_vectorized.cpp
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NUMfft_vectorized.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+	#define NUMfft_HAVE_AVX2_VARIANT  1
+	#define NUMfft_ALWAYS_INLINE  inline __attribute__ ((always_inline))
+#else
+	#define NUMfft_HAVE_AVX2_VARIANT  0
+	#define NUMfft_ALWAYS_INLINE  inline
+#endif
+
+/*
+	No fused multiply-adds: they round differently from a multiplication followed by an addition,
+	so results would depend on the processor (and on whether the compiler chose to fuse).
+	Hence also no FMA in the AVX2 variant: every variant gives bitwise the same results.
+*/
+#if defined (__clang__)
+	#pragma clang fp contract (off)
+#elif defined (__GNUC__)
+	#pragma GCC optimize ("fp-contract=off")
+#endif
+
+/*
+	Some loops write to several places in the same array (or in different parts of the workspace) that never overlap
+	with what the loop reads, but the compiler cannot know that, unless we tell it.
+*/
+#if defined (__clang__)
+	#define NUMfft_INDEPENDENT_ITERATIONS  _Pragma ("clang loop vectorize (assume_safety)")
+#elif defined (__GNUC__)
+	#define NUMfft_INDEPENDENT_ITERATIONS  _Pragma ("GCC ivdep")
+#else
+	#define NUMfft_INDEPENDENT_ITERATIONS
+#endif
+
+struct structNUMfft_VectorizedPlan {
+	integer n, numberOfComplexPoints;
+	/*
+		For the radix-4 stages of lengths numberOfComplexPoints, numberOfComplexPoints / 4, ... (down to 4),
+		one after the other: cos and sin of 2 pi k p / length, at [(k - 1) * length / 4 + p], for k = 1 .. 3 and p = 0 .. length / 4 - 1.
+	*/
+	std::vector <double> stageCos, stageSin;
+	std::vector <double> splitCos, splitSin;   // cos and sin of 2 pi k / n, for k = 0 .. numberOfComplexPoints - 1
+};
+
+/*
+	The butterfly of a Stockham radix-4 stage, with the twiddle factors exp (-2 pi i k p / length).
+*/
+NUMfft_ALWAYS_INLINE static void butterfly4 (const double *xr, const double *xi, integer in, integer inStep,
+	double *yr, double *yi, integer out, integer outStep,
+	double c1, double s1, double c2, double s2, double c3, double s3)
+{
+	const double ar = xr [in], ai = xi [in];
+	const double br = xr [in + inStep], bi = xi [in + inStep];
+	const double cr = xr [in + 2 * inStep], ci = xi [in + 2 * inStep];
+	const double dr = xr [in + 3 * inStep], di = xi [in + 3 * inStep];
+	const double apcr = ar + cr, apci = ai + ci, amcr = ar - cr, amci = ai - ci;
+	const double bpdr = br + dr, bpdi = bi + di, bmdr = br - dr, bmdi = bi - di;
+	const double t1r = amcr + bmdi, t1i = amci - bmdr;   // (a - c) - i (b - d)
+	const double t2r = apcr - bpdr, t2i = apci - bpdi;
+	const double t3r = amcr - bmdi, t3i = amci + bmdr;   // (a - c) + i (b - d)
+	yr [out] = apcr + bpdr;
+	yi [out] = apci + bpdi;
+	yr [out + outStep] = t1r * c1 + t1i * s1;
+	yi [out + outStep] = t1i * c1 - t1r * s1;
+	yr [out + 2 * outStep] = t2r * c2 + t2i * s2;
+	yi [out + 2 * outStep] = t2i * c2 - t2r * s2;
+	yr [out + 3 * outStep] = t3r * c3 + t3i * s3;
+	yi [out + 3 * outStep] = t3i * c3 - t3r * s3;
+}
+
+/*
+	The inner loop runs over the `stride` contiguous transforms that a Stockham stage interleaves,
+	except in the first stage, where there is only one, and the loop runs over the butterflies instead.
+*/
+NUMfft_ALWAYS_INLINE static void radix4Stage (integer length, integer stride,
+	const double *__restrict xr, const double *__restrict xi, double *__restrict yr, double *__restrict yi,
+	const double *__restrict wc, const double *__restrict ws)
+{
+	const integer m = length / 4;
+	if (stride == 1) {
+		NUMfft_INDEPENDENT_ITERATIONS
+		for (integer p = 0; p < m; p ++)
+			butterfly4 (xr, xi, p, m, yr, yi, 4 * p, 1, wc [p], ws [p], wc [m + p], ws [m + p], wc [2 * m + p], ws [2 * m + p]);
+	} else {
+		for (integer p = 0; p < m; p ++) {
+			const double c1 = wc [p], s1 = ws [p], c2 = wc [m + p], s2 = ws [m + p], c3 = wc [2 * m + p], s3 = ws [2 * m + p];
+			NUMfft_INDEPENDENT_ITERATIONS
+			for (integer q = 0; q < stride; q ++)
+				butterfly4 (xr, xi, q + stride * p, stride * m, yr, yi, q + 4 * stride * p, stride, c1, s1, c2, s2, c3, s3);
+		}
+	}
+}
+
+NUMfft_ALWAYS_INLINE static void radix2Stage (integer stride,
+	const double *__restrict xr, const double *__restrict xi, double *__restrict yr, double *__restrict yi)
+{
+	NUMfft_INDEPENDENT_ITERATIONS
+	for (integer q = 0; q < stride; q ++) {
+		const double ar = xr [q], ai = xi [q], br = xr [q + stride], bi = xi [q + stride];
+		yr [q] = ar + br;
+		yi [q] = ai + bi;
+		yr [q + stride] = ar - br;
+		yi [q + stride] = ai - bi;
+	}
+}
+
+/*
+	The complex forward transform of re [0..numberOfComplexPoints - 1] + i im [...], using other* as the second buffer.
+	On return, re and im point to the result, in whichever buffer that is.
+*/
+NUMfft_ALWAYS_INLINE static void complexForward (const structNUMfft_VectorizedPlan *me, double *& re, double *& im, double *& otherRe, double *& otherIm) {
+	const double *wc = my stageCos.data (), *ws = my stageSin.data ();
+	integer length = my numberOfComplexPoints, stride = 1;
+	for (; length >= 4; length /= 4, stride *= 4) {
+		radix4Stage (length, stride, re, im, otherRe, otherIm, wc, ws);
+		wc += 3 * (length / 4);
+		ws += 3 * (length / 4);
+		std::swap (re, otherRe);
+		std::swap (im, otherIm);
+	}
+	if (length == 2) {
+		radix2Stage (stride, re, im, otherRe, otherIm);
+		std::swap (re, otherRe);
+		std::swap (im, otherIm);
+	}
+}
+
+/*
+	With z [k] = x [2k] + i x [2k+1] and Z its transform of size m = n/2, the transform of x is
+	X [k] = (Z [k] + conj (Z [m-k])) / 2 - i exp (-2 pi i k / n) (Z [k] - conj (Z [m-k])) / 2.
+*/
+NUMfft_ALWAYS_INLINE static void realForward (const structNUMfft_VectorizedPlan *me, double *__restrict data, double *__restrict workspace) {
+	const integer m = my numberOfComplexPoints;
+	double *re = workspace, *im = workspace + m, *otherRe = workspace + 2 * m, *otherIm = workspace + 3 * m;
+	for (integer k = 0; k < m; k ++) {
+		re [k] = data [2 * k + 1];
+		im [k] = data [2 * k + 2];
+	}
+	complexForward (me, re, im, otherRe, otherIm);
+	const double *c = my splitCos.data (), *s = my splitSin.data ();
+	data [1] = re [0] + im [0];
+	data [my n] = re [0] - im [0];
+	for (integer k = 1; k < m; k ++) {
+		const double sumr = 0.5 * (re [k] + re [m - k]), sumi = 0.5 * (im [k] - im [m - k]);
+		const double oddr = 0.5 * (im [k] + im [m - k]), oddi = - 0.5 * (re [k] - re [m - k]);
+		data [2 * k] = sumr + c [k] * oddr + s [k] * oddi;
+		data [2 * k + 1] = sumi + c [k] * oddi - s [k] * oddr;
+	}
+}
+
+/*
+	The reverse of realForward, without the halvings, so that it multiplies by n as FFTPACK does.
+	The complex backward transform is computed as the conjugate of the forward transform of the conjugate.
+*/
+NUMfft_ALWAYS_INLINE static void realBackward (const structNUMfft_VectorizedPlan *me, double *__restrict data, double *__restrict workspace) {
+	const integer m = my numberOfComplexPoints;
+	double *re = workspace, *im = workspace + m, *otherRe = workspace + 2 * m, *otherIm = workspace + 3 * m;
+	const double *c = my splitCos.data (), *s = my splitSin.data ();
+	double *xr = otherRe, *xi = otherIm;   // X [k] for k = 1 .. m - 1, contiguously, so that it can be read backwards as well
+	for (integer k = 1; k < m; k ++) {
+		xr [k] = data [2 * k];
+		xi [k] = data [2 * k + 1];
+	}
+	re [0] = data [1] + data [my n];
+	im [0] = data [my n] - data [1];
+	NUMfft_INDEPENDENT_ITERATIONS
+	for (integer k = 1; k < m; k ++) {
+		const double sumr = xr [k] + xr [m - k], sumi = xi [k] - xi [m - k];
+		const double differencer = xr [k] - xr [m - k], differencei = xi [k] + xi [m - k];   // with conj (X [m-k])
+		const double oddr = differencer * c [k] - differencei * s [k], oddi = differencer * s [k] + differencei * c [k];
+		re [k] = sumr - oddi;
+		im [k] = - (sumi + oddr);
+	}
+	complexForward (me, re, im, otherRe, otherIm);
+	for (integer k = 0; k < m; k ++) {
+		data [2 * k + 1] = re [k];
+		data [2 * k + 2] = - im [k];
+	}
+}
+
+NUMfft_ALWAYS_INLINE static void complexForwardInPlace (const structNUMfft_VectorizedPlan *me, double *re, double *im, double *workspace) {
+	const integer m = my numberOfComplexPoints;
+	double *resultRe = re, *resultIm = im, *otherRe = workspace, *otherIm = workspace + m;
+	complexForward (me, resultRe, resultIm, otherRe, otherIm);
+	if (resultRe != re) {
+		std::copy (resultRe, resultRe + m, re);
+		std::copy (resultIm, resultIm + m, im);
+	}
+}
+
+static void realForward_generic (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+	realForward (me, data, workspace);
+}
+
+static void realBackward_generic (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+	realBackward (me, data, workspace);
+}
+
+static void complexForward_generic (const structNUMfft_VectorizedPlan *me, double *re, double *im, double *workspace) {
+	complexForwardInPlace (me, re, im, workspace);
+}
+
+#if NUMfft_HAVE_AVX2_VARIANT
+	__attribute__ ((target ("avx2")))
+	static void complexForward_avx2 (const structNUMfft_VectorizedPlan *me, double *re, double *im, double *workspace) {
+		complexForwardInPlace (me, re, im, workspace);
+	}
+
+	__attribute__ ((target ("avx2")))
+	static void realForward_avx2 (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+		realForward (me, data, workspace);
+	}
+
+	__attribute__ ((target ("avx2")))
+	static void realBackward_avx2 (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+		realBackward (me, data, workspace);
+	}
+
+	static bool useAvx2 () {
+		static const bool processorHasAvx2 = [] {
+			__builtin_cpu_init ();
+			return __builtin_cpu_supports ("avx2");
+		} ();
+		return processorHasAvx2 && Melder_debug != 53;
+	}
+#endif
+
+structNUMfft_VectorizedPlan *NUMfft_VectorizedPlan_create (integer n) {
+	Melder_assert (n >= 2 && (n & (n - 1)) == 0);
+	auto me = std::make_unique <structNUMfft_VectorizedPlan> ();
+	my n = n;
+	my numberOfComplexPoints = n / 2;
+	const integer m = my numberOfComplexPoints;
+
+	/*
+		Only the first octant of the circle is computed with cos and sin; the rest follows from its symmetries,
+		which is faster for large n, and makes the symmetric values exactly equal.
+	*/
+	my splitCos.resize ((size_t) m);
+	my splitSin.resize ((size_t) m);
+	double *c = my splitCos.data (), *s = my splitSin.data ();
+	for (integer j = 0; j < m; j ++) {
+		if (8 * j <= n) {
+			const double phase = NUM2pi * double (j) / n;
+			c [j] = cos (phase);
+			s [j] = sin (phase);
+		} else if (4 * j <= n) {
+			c [j] = s [n / 4 - j];
+			s [j] = c [n / 4 - j];
+		} else {
+			c [j] = - c [n / 2 - j];
+			s [j] = s [n / 2 - j];
+		}
+	}
+
+	integer numberOfStageFactors = 0;
+	for (integer length = m; length >= 4; length /= 4)
+		numberOfStageFactors += 3 * (length / 4);
+	my stageCos.resize ((size_t) numberOfStageFactors);
+	my stageSin.resize ((size_t) numberOfStageFactors);
+	integer offset = 0;
+	for (integer length = m; length >= 4; length /= 4) {
+		for (integer k = 1; k <= 3; k ++) {
+			for (integer p = 0; p < length / 4; p ++, offset ++) {
+				const integer j = k * p * (n / length);   // 2 pi k p / length = 2 pi j / n, with j < 3n/4
+				my stageCos [(size_t) offset] = j < m ? c [j] : - c [j - m];
+				my stageSin [(size_t) offset] = j < m ? s [j] : - s [j - m];
+			}
+		}
+	}
+	Melder_assert (offset == numberOfStageFactors);
+	return me.release ();
+}
+
+void NUMfft_VectorizedPlan_delete (structNUMfft_VectorizedPlan *me) {
+	delete me;
+}
+
+integer NUMfft_VectorizedPlan_getSize (const structNUMfft_VectorizedPlan *me) {
+	return (integer) (sizeof (structNUMfft_VectorizedPlan) + sizeof (double) *
+		(my stageCos.size () + my stageSin.size () + my splitCos.size () + my splitSin.size ()));
+}
+
+void NUMfft_VectorizedPlan_forward (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+	#if NUMfft_HAVE_AVX2_VARIANT
+		if (useAvx2 ())
+			return realForward_avx2 (me, data, workspace);
+	#endif
+	realForward_generic (me, data, workspace);
+}
+
+void NUMfft_VectorizedPlan_backward (const structNUMfft_VectorizedPlan *me, double *data, double *workspace) {
+	#if NUMfft_HAVE_AVX2_VARIANT
+		if (useAvx2 ())
+			return realBackward_avx2 (me, data, workspace);
+	#endif
+	realBackward_generic (me, data, workspace);
+}
+
+void NUMfft_VectorizedPlan_complexForward (const structNUMfft_VectorizedPlan *me, double *re, double *im, double *workspace) {
+	#if NUMfft_HAVE_AVX2_VARIANT
+		if (useAvx2 ())
+			return complexForward_avx2 (me, re, im, workspace);
+	#endif
+	complexForward_generic (me, re, im, workspace);
+}
+
+/* End of file NUMfft_vectorized.cpp */
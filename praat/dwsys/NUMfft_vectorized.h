@@ -0,0 +1,65 @@
+#ifndef _NUMfft_vectorized_h_
+#define _NUMfft_vectorized_h_
+/* NUMfft_vectorized.h
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "melder.h"
+
+/*
+	A real FFT for sizes that are powers of two, as the backend of NUMfft_Table.
+
+	The real transform of size n is computed as a complex transform of size n/2 (of the even samples as real parts
+	and the odd samples as imaginary parts), with radix-4 Stockham stages on separate arrays of real and imaginary parts,
+	so that the compiler can vectorize all inner loops. On x86 processors with AVX2, a variant compiled
+	for these instructions is chosen at run time, unless Melder_debug is 53. Multiply-adds are never fused,
+	so that all variants give bitwise the same results on every processor; these differ from FFTPACK's
+	(which NUMfft_Table uses for all sizes if Melder_debug is 52) by rounding errors only.
+
+	The input and output are in the same order as those of NUMfft_forward and NUMfft_backward (i.e. FFTPACK's),
+	including the normalization: a backward transform after a forward transform multiplies by n.
+*/
+
+struct structNUMfft_VectorizedPlan;
+
+structNUMfft_VectorizedPlan *NUMfft_VectorizedPlan_create (integer n);
+/*
+	Precondition:
+		n is a power of two of at least 2.
+	Postcondition:
+		the plan is never changed, so it can be used from several threads at the same time;
+		NUMfft_Table_init shares the plans of the sizes it uses between all tables (see NUMfft_d.cpp).
+*/
+
+void NUMfft_VectorizedPlan_delete (structNUMfft_VectorizedPlan *me);
+
+integer NUMfft_VectorizedPlan_getSize (const structNUMfft_VectorizedPlan *me);   // in bytes
+
+void NUMfft_VectorizedPlan_forward (const structNUMfft_VectorizedPlan *me, double *data, double *workspace);
+void NUMfft_VectorizedPlan_backward (const structNUMfft_VectorizedPlan *me, double *data, double *workspace);
+/*
+	data [1..n]; workspace [0..2n-1], not shared with other threads.
+*/
+
+void NUMfft_VectorizedPlan_complexForward (const structNUMfft_VectorizedPlan *me, double *re, double *im, double *workspace);
+/*
+	The complex forward transform of size m = n/2 (the one inside the real transform of size n), without normalization:
+	re [0..m-1] + i im [0..m-1] is replaced with its transform; workspace [0..n-1], not shared with other threads.
+*/
+
+/* End of file NUMfft_vectorized.h */
+#endif
@@ -208,4 +208,53 @@ autoMatrix MFCC_to_Matrix_features (MFCC me, double windowLength, bool includeEn
 	}
 }
 
+static void NUMregressionDeltas (constMAT values, MAT deltas, integer numberOfFramesEachSide) {
+	const integer numberOfFrames = values.ncol;
+	double denominator = 0.0;
+	for (integer m = 1; m <= numberOfFramesEachSide; m ++)
+		denominator += (double) m * (double) m;
+	denominator *= 2.0;
+	for (integer irow = 1; irow <= values.nrow; irow ++) {
+		const double *c = values [irow];
+		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+			double sum = 0.0;
+			for (integer m = 1; m <= numberOfFramesEachSide; m ++) {
+				const integer later = std::min (iframe + m, numberOfFrames), earlier = std::max (iframe - m, integer (1));
+				sum += m * (c [later] - c [earlier]);
+			}
+			deltas [irow] [iframe] = sum / denominator;
+		}
+	}
+}
+
+autoMatrix MFCC_to_Matrix_withDeltas (MFCC me, integer numberOfFramesEachSide, bool includeDeltaDeltas) {
+	try {
+		Melder_require (numberOfFramesEachSide > 0,
+			U"The number of frames on each side should be positive.");
+		Melder_require (my nx > 0,
+			U"There should be at least one frame.");
+		const integer numberOfCoefficients = my frame [1]. numberOfCoefficients;
+		for (integer iframe = 2; iframe <= my nx; iframe ++) {
+			Melder_require (my frame [iframe]. numberOfCoefficients == numberOfCoefficients,
+				U"All frames should have the same number of coefficients.");
+		}
+		const integer numberOfRows = numberOfCoefficients + 1;
+		const integer numberOfFeatures = ( includeDeltaDeltas ? 3 : 2 ) * numberOfRows;
+		autoMatrix thee = Matrix_create (my xmin, my xmax, my nx, my dx, my x1, 1.0, numberOfFeatures, numberOfFeatures, 1.0, 1.0);
+		for (integer iframe = 1; iframe <= my nx; iframe ++) {
+			CC_Frame cf = & my frame [iframe];
+			thy z [1] [iframe] = cf -> c0;
+			for (integer i = 1; i <= numberOfCoefficients; i ++)
+				thy z [i + 1] [iframe] = cf -> c [i];
+		}
+		MAT features (thy z, numberOfFeatures, my nx);
+		NUMregressionDeltas (features.horizontalBand (1, numberOfRows), features.horizontalBand (numberOfRows + 1, 2 * numberOfRows), numberOfFramesEachSide);
+		if (includeDeltaDeltas)
+			NUMregressionDeltas (features.horizontalBand (numberOfRows + 1, 2 * numberOfRows), features.horizontalBand (2 * numberOfRows + 1, 3 * numberOfRows), numberOfFramesEachSide);
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": no Matrix with deltas created.");
+	}
+}
+
 /* End of file MFCC.cpp */
@@ -73,4 +73,13 @@ autoSound MFCCs_convolve (MFCC me, MFCC thee, kSounds_convolve_scaling scaling,
 
 autoMatrix MFCC_to_Matrix_features (MFCC me, double windowLength, bool includeEnergy);
 
+autoMatrix MFCC_to_Matrix_withDeltas (MFCC me, integer numberOfFramesEachSide, bool includeDeltaDeltas);
+/*
+	Rows c0, c1 .. cN, followed by their deltas and (optionally) their delta-deltas; one column per frame.
+	The delta of a coefficient in frame t is the slope of its regression line over the frames t - M .. t + M
+	(M = numberOfFramesEachSide), with the first and last frames repeated beyond the edges:
+		d [t] = sum (m = 1..M) m * (c [t + m] - c [t - m]) / (2 * sum (m = 1..M) m^2)
+	The delta-deltas are the deltas of the deltas.
+*/
+
 #endif /* _MFCC_h_ */
@@ -31,6 +31,13 @@
 #include "Sound_to_Pitch.h"
 #include "Vector.h"
 #include "NUM2.h"
+#include "MelderThread.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #define MIN(m,n) ((m) < (n) ? (m) : (n))
 // prototypes
@@ -45,7 +52,7 @@ autoSound BandFilterSpectrogram_as_Sound (BandFilterSpectrogram me, int to_dB);
 	where erf(x) = 1 - erfc(x) and n is the windowLength in samples.
 	To compare with the rectangular window we need to divide this by the window width (n -1) x 1^2.
 */
-static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+static double _Spectrogram_windowCorrectionFactor (integer numberOfSamples_window) {
 	double windowFactor = 1.0;
 	if (numberOfSamples_window > 1) {
 		double e12 = exp (-12);
@@ -56,6 +63,11 @@ static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSampl
 		double p1 = 4 * NUMsqrtpi * NUMsqrt3 * e12 * (1 - NUMerfcc (arg1)) * (numberOfSamples_window + 1);
 		windowFactor =  (p2 - p1 + 24 * (numberOfSamples_window - 1) * e12 * e12) / denum;
 	}
+	return windowFactor;
+}
+
+static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+	double windowFactor = _Spectrogram_windowCorrectionFactor (numberOfSamples_window);
 	for (integer i = 1; i <= my ny; i ++) {
 		for (integer j = 1; j <= my nx; j ++) {
 			my z [i] [j] /= windowFactor;
@@ -63,53 +75,197 @@ static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSampl
 	}
 }
 
-static autoSpectrum Sound_to_Spectrum_power (Sound me) {
-	try {
-		autoSpectrum thee = Sound_to_Spectrum (me, true);
-		double scale = 2.0 * thy dx / (my xmax - my xmin);
-
-		// factor '2' because we combine positive and negative frequencies
-		// thy dx : width of frequency bin
-		// my xmax - my xmin : duration of sound
+/*
+	The frequencies of the spectrum that Sound_to_Spectrum (frame, true) computes from a frame, without its values:
+	bin i is at (i - 1) * dx, up to the Nyquist frequency.
+*/
+static autoSpectrum Sound_to_Spectrum_bins (Sound frame) {
+	integer numberOfSamples = 2;
+	while (numberOfSamples < frame -> nx) numberOfSamples *= 2;
+	autoSpectrum thee = Spectrum_create (0.5 / frame -> dx, numberOfSamples / 2 + 1);
+	thy dx = 1.0 / (frame -> dx * numberOfSamples);   // as in Sound_to_Spectrum
+	return thee;
+}
 
-		double *re = thy z [1], *im = thy z [2];
-		for (integer i = 1; i <= thy nx; i ++) {
-			double power = scale * (re [i] * re [i] + im [i] * im [i]);
-			re [i] = power; im [i] = 0;
+/*
+	Analyses the frames of `thee` in blocks, each thread with its own buffers and FFT table.
+	For every block, intoBlock (power, firstFrame, lastFrame) receives the power spectrum
+	of the Gaussian-windowed frame iframe in power [iframe - firstFrame + 1] [1..bins -> nx],
+	with the bins of Sound_to_Spectrum_bins. The power is scaled by a factor 2 because we combine positive and negative
+	frequencies (the bins at 0 Hz and at the Nyquist frequency don't count for two), times the width of a frequency bin,
+	divided by the duration of the window.
+	Frames of a block are written by a single thread, so intoBlock can fill the columns of these frames.
+*/
+template <typename IntoBlock>
+static void Sound_into_BandFilterSpectrogram (Sound me, Sampled thee, Sound window, Spectrum bins, IntoBlock intoBlock) {
+	const integer numberOfFrames = thy nx, numberOfBins = bins -> nx, nfft = 2 * (numberOfBins - 1);
+	const integer nsamp_window = window -> nx;
+	const double windowDuration = window -> xmax - window -> xmin;
+	const double sampleScaling = window -> dx, powerScaling = 2.0 * bins -> dx / windowDuration;
+	auto power = [=] (double re, double im) { return powerScaling * (re * re + im * im); };
+
+	constexpr integer numberOfFramesPerBlock = 16;
+	const integer numberOfThreads = MelderThread_getNumberOfThreads (numberOfFrames, numberOfFramesPerBlock);
+	struct Scratch {
+		autoNUMvector <double> data;
+		autoMAT powerSpectra;   // [1..numberOfFramesPerBlock] [1..numberOfBins]
+		autoNUMfft_Table fftTable;
+	};
+	std::vector <Scratch> scratch ((size_t) numberOfThreads);
+	for (Scratch& s : scratch) {
+		s.data.reset (1, nfft);
+		s.powerSpectra = MATraw (numberOfFramesPerBlock, numberOfBins);
+		NUMfft_Table_init (& s.fftTable, nfft);
+	}
+	std::atomic <integer> numberOfFramesDone { 0 };
+	MelderThread_parallelFor (numberOfFrames, numberOfFramesPerBlock, numberOfThreads,
+		[&] (integer firstFrame, integer lastFrame, integer ithread) {
+			double *data = scratch [(size_t) ithread - 1]. data.peek();
+			MAT powerSpectra = scratch [(size_t) ithread - 1]. powerSpectra.get();
+			NUMfft_Table fftTable = & scratch [(size_t) ithread - 1]. fftTable;
+			if (ithread == 1) {   // only the calling thread can talk to the user
+				const integer numberOfFramesDoneSoFar = numberOfFramesDone;
+				Melder_progress ((double) numberOfFramesDoneSoFar / numberOfFrames, U"Frame ",
+					numberOfFramesDoneSoFar + 1, U" out of ", numberOfFrames, U".");
+			}
+			for (integer firstInBlock = firstFrame; firstInBlock <= lastFrame; firstInBlock += numberOfFramesPerBlock) {   // a single thread gets all frames at once
+				const integer lastInBlock = std::min (firstInBlock + numberOfFramesPerBlock - 1, lastFrame);
+				for (integer iframe = firstInBlock; iframe <= lastInBlock; iframe ++) {
+					const double t = Sampled_indexToX (thee, iframe);
+					const integer index = Sampled_xToNearestIndex (me, t - windowDuration / 2.0);
+					for (integer i = 1; i <= nsamp_window; i ++) {
+						const integer j = index - 1 + i;
+						data [i] = ( j < 1 || j > my nx ? 0.0 : my z [1] [j] ) * window -> z [1] [i];
+					}
+					for (integer i = nsamp_window + 1; i <= nfft; i ++) {
+						data [i] = 0.0;
+					}
+					NUMfft_forward (fftTable, data);
+
+					double *p = powerSpectra [iframe - firstInBlock + 1];
+					p [1] = 0.5 * power (data [1] * sampleScaling, 0.0);
+					for (integer i = 2; i < numberOfBins; i ++) {
+						p [i] = power (data [i + i - 2] * sampleScaling, data [i + i - 1] * sampleScaling);
+					}
+					p [numberOfBins] = 0.5 * power (data [nfft] * sampleScaling, 0.0);
+				}
+				intoBlock (powerSpectra, firstInBlock, lastInBlock);
+			}
+			numberOfFramesDone += lastFrame - firstFrame + 1;
 		}
+	);
+}
 
-		// Correction of frequency bins at 0 Hz and nyquist: don't count for two.
+/*
+	The weights of a bank of filters on the bins of a power spectrum, in compressed rows:
+	filter i has the weights [firstWeight [i - 1] .. firstWeight [i] - 1] (base 0)
+	on the consecutive bins from bin firstBin [i - 1] on.
+	Zero weights within the band of a filter are kept, so that applying a filter adds the same terms in the same order
+	as evaluating its amplitude for every bin of the band in every frame.
+*/
+struct BandFilterBank {
+	integer numberOfFilters = 0;
+	std::vector <integer> firstBin, firstWeight { 0 };
+	std::vector <double> weights;
+
+	double applyTo (integer ifilter, const double power []) const {
+		const double *w = weights.data () + firstWeight [(size_t) ifilter - 1];
+		const double *p = power + firstBin [(size_t) ifilter - 1];
+		const integer numberOfWeights = firstWeight [(size_t) ifilter] - firstWeight [(size_t) ifilter - 1];
+		double sum = 0.0;
+		for (integer k = 0; k < numberOfWeights; k ++)
+			sum += w [k] * p [k];
+		return sum;
+	}
+};
 
-		re [1] *= 0.5; re [thy nx] *= 0.5;
-		return thee;
-	} catch (MelderError) {
-		Melder_throw (me, U": no Spectrum with spectral power created.");
+/*
+	band (ifilter, & ifrom, & ito) gives the bins of each filter, weight (ifilter, ibin) its amplitude in each of these bins.
+*/
+template <typename Band, typename Weight>
+static std::shared_ptr <const BandFilterBank> BandFilterBank_create (integer numberOfFilters, Band band, Weight weight) {
+	auto me = std::make_shared <BandFilterBank> ();
+	my numberOfFilters = numberOfFilters;
+	for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+		integer ifrom, ito;
+		band (ifilter, & ifrom, & ito);
+		my firstBin.push_back (ifrom);
+		for (integer ibin = ifrom; ibin <= ito; ibin ++)
+			my weights.push_back (weight (ifilter, ibin));
+		my firstWeight.push_back ((integer) my weights.size ());
 	}
+	return me;
 }
 
-static void Sound_into_BarkSpectrogram_frame (Sound me, BarkSpectrogram thee, integer frame) {
-	autoSpectrum him = Sound_to_Spectrum_power (me);
-	integer numberOfFrequencies = his nx;
-	autoNUMvector<double> z (1, numberOfFrequencies);
+/*
+	The filter banks of the last few analyses, so that e.g. the MFCCs of many sounds with the same sampling frequency
+	and settings are computed with the same weights. A bank is never changed after it has been created,
+	so it can be used by several threads at the same time.
+*/
+struct BandFilterBank_Key {
+	ClassInfo spectrogramClass;   // the filter shapes and frequency scale
+	integer numberOfBins;
+	double binWidth;
+	integer numberOfFilters;
+	double firstFilter, filterDistance;
+	bool operator== (const BandFilterBank_Key& other) const {
+		return spectrogramClass == other.spectrogramClass && numberOfBins == other.numberOfBins && binWidth == other.binWidth &&
+			numberOfFilters == other.numberOfFilters && firstFilter == other.firstFilter && filterDistance == other.filterDistance;
+	}
+};
+
+class BandFilterBank_Cache {
+public:
+	std::shared_ptr <const BandFilterBank> find (const BandFilterBank_Key& key) {
+		std::lock_guard <std::mutex> lock (d_mutex);
+		for (auto it = d_recentBanks.begin (); it != d_recentBanks.end (); ++ it) {
+			if (it -> first == key) {
+				d_recentBanks.splice (d_recentBanks.begin (), d_recentBanks, it);   // most recently used first
+				return it -> second;
+			}
+		}
+		return nullptr;
+	}
+	void add (const BandFilterBank_Key& key, std::shared_ptr <const BandFilterBank> bank) {
+		std::lock_guard <std::mutex> lock (d_mutex);
+		d_recentBanks.emplace_front (key, std::move (bank));
+		if (d_recentBanks.size () > maximumNumberOfBanks)
+			d_recentBanks.pop_back ();
+	}
+private:
+	static constexpr size_t maximumNumberOfBanks = 8;
+	std::mutex d_mutex;
+	std::list <std::pair <BandFilterBank_Key, std::shared_ptr <const BandFilterBank>>> d_recentBanks;
+};
+
+static BandFilterBank_Cache& theBandFilterBankCache () {
+	static BandFilterBank_Cache *cache = new BandFilterBank_Cache;   // never destroyed, like the FFT plans
+	return *cache;
+}
 
-	for (integer ifreq = 1; ifreq <= numberOfFrequencies; ifreq ++) {
-		double fhz = his x1 + (ifreq - 1) * his dx;
-		z [ifreq] = thy v_hertzToFrequency (fhz);
+/*
+	Looks up the filter bank with this key, or calls create () and remembers the result.
+	Two threads may occasionally both create the same bank; both get a correct one.
+*/
+template <typename Create>
+static std::shared_ptr <const BandFilterBank> BandFilterBank_getCached (const BandFilterBank_Key& key, Create create) {
+	std::shared_ptr <const BandFilterBank> bank = theBandFilterBankCache (). find (key);
+	if (! bank) {
+		bank = create ();
+		theBandFilterBankCache (). add (key, bank);
 	}
+	return bank;
+}
 
-	for (integer i = 1; i <= thy ny; i ++) {
-		double p = 0;
-		double z0 = thy y1 + (i - 1) * thy dy;
-		double *pow = his z [1]; // TODO ??
-		for (integer ifreq = 1; ifreq <= numberOfFrequencies; ifreq ++) {
-			// Sekey & Hanson filter is defined in the power domain.
-			// We therefore multiply the power with a (and not a^2).
-			// integral (F(z),z=0..25) = 1.58/9
-
-			double a = NUMsekeyhansonfilter_amplitude (z0, z [ifreq]);
-			p += a * pow [ifreq] ;
+/*
+	Fills the columns of a block of frames of `thee` by applying the filter bank to the power spectra of these frames.
+*/
+static void BandFilterSpectrogram_applyFilterBank (BandFilterSpectrogram thee, const BandFilterBank& bank, MAT powerSpectra, integer firstFrame, integer lastFrame) {
+	for (integer ifilter = 1; ifilter <= bank.numberOfFilters; ifilter ++) {
+		double *row = thy z [ifilter];
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			row [iframe] = bank.applyTo (ifilter, powerSpectra [iframe - firstFrame + 1]);
 		}
-		thy z [i] [frame] = p;
 	}
 }
 
@@ -145,20 +301,37 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
 		autoBarkSpectrogram thee = BarkSpectrogram_create (my xmin, my xmax, numberOfFrames, dt, t1, fmin_bark, fmax_bark, numberOfFilters, df_bark, f1_bark);
 
-		autoMelderProgress progess (U"BarkSpectrogram analysis");
-
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			double t = Sampled_indexToX (thee.get(), iframe);
-
-			Sound_into_Sound (me, sframe.get(), t - windowDuration / 2.0);
-			Sounds_multiply (sframe.get(), window.get());
-			Sound_into_BarkSpectrogram_frame (sframe.get(), thee.get(), iframe);
+		autoSpectrum bins = Sound_to_Spectrum_bins (sframe.get());
+		const BandFilterBank_Key key { classBarkSpectrogram, bins -> nx, bins -> dx, thy ny, thy y1, thy dy };
+		std::shared_ptr <const BandFilterBank> filterBank = BandFilterBank_getCached (key, [&] {
+			autoNUMvector <double> z (1, bins -> nx);
+			for (integer ifreq = 1; ifreq <= bins -> nx; ifreq ++) {
+				double fhz = bins -> x1 + (ifreq - 1) * bins -> dx;
+				z [ifreq] = thy v_hertzToFrequency (fhz);
+			}
+			/*
+				Unlike the triangular Mel filters, the Sekey & Hanson filters are nowhere zero, so every row is kept dense,
+				over all bins: trimming the rows at some threshold would save time, but would no longer give the same values
+				as summing over all bins, as BarkSpectrogram analyses always have.
+			*/
+			return BandFilterBank_create (thy ny,
+				[&] (integer, integer *ifrom, integer *ito) { *ifrom = 1; *ito = bins -> nx; },
+				[&] (integer ifilter, integer ifreq) {
+					// Sekey & Hanson filter is defined in the power domain.
+					// We therefore multiply the power with a (and not a^2).
+					// integral (F(z),z=0..25) = 1.58/9
+					double z0 = thy y1 + (ifilter - 1) * thy dy;
+					return NUMsekeyhansonfilter_amplitude (z0, z [ifreq]);
+				}
+			);
+		});
 
-			if (iframe % 10 == 1) {
-				Melder_progress ( (double) iframe / numberOfFrames,  U"BarkSpectrogram analysis: frame ",
-					iframe, U" from ", numberOfFrames, U".");
+		autoMelderProgress progess (U"BarkSpectrogram analysis");
+		Sound_into_BandFilterSpectrogram (me, thee.get(), window.get(), bins.get(),
+			[&] (MAT powerSpectra, integer firstFrame, integer lastFrame) {
+				BandFilterSpectrogram_applyFilterBank (thee.get(), *filterBank, powerSpectra, firstFrame, lastFrame);
 			}
-		}
+		);
 		
 		_Spectrogram_windowCorrection ((Spectrogram) thee.get(), window -> nx);
 
@@ -168,76 +341,89 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 	}
 }
 
-static void Sound_into_MelSpectrogram_frame (Sound me, MelSpectrogram thee, integer frame) {
-	autoSpectrum him = Sound_to_Spectrum_power (me);
+void Sound_initMelAnalysis (Sound me, MelAnalysis *thee, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
+	double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
+	double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	double fmin_mel = 0.0;
+	double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
 
-	for (integer ifilter = 1; ifilter <= thy ny; ifilter ++) {
-		double power = 0;
-		double fc_mel = thy y1 + (ifilter - 1) * thy dy;
-		double fc_hz = thy v_frequencyToHertz (fc_mel);
-		double fl_hz = thy v_frequencyToHertz (fc_mel - thy dy);
-		double fh_hz =  thy v_frequencyToHertz (fc_mel + thy dy);
-		integer ifrom, ito;
-		Sampled_getWindowSamples (him.get(), fl_hz, fh_hz, & ifrom, & ito);
-		for (integer i = ifrom; i <= ito; i ++) {
-			// Bin with a triangular filter the power (= amplitude-squared)
+	// Check defaults.
 
-			double f = his x1 + (i - 1) * his dx;
-			double a = NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, f);
-			power += a * his z [1] [i];
-		}
-		thy z [ifilter] [frame] = power;
+	if (fmax_mel <= 0.0 || fmax_mel > fceiling) {
+		fmax_mel = fceiling;
+	}
+	if (fmax_mel <= f1_mel) {
+		f1_mel = fbottom; fmax_mel = fceiling;
 	}
+	if (f1_mel <= 0.0) {
+		f1_mel = fbottom;
+	}
+	if (df_mel <= 0.0) {
+		df_mel = 100.0;
+	}
+
+	// Determine the number of filters.
+
+	integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
+	fmax_mel = f1_mel + numberOfFilters * df_mel;
+
+	Sampled_shortTermAnalysis (me, windowDuration, dt, & thy numberOfFrames, & thy t1);
+	thy numberOfFilters = numberOfFilters;
+	thy fmin_mel = fmin_mel;
+	thy fmax_mel = fmax_mel;
+	thy f1_mel = f1_mel;
+	thy df_mel = df_mel;
+	autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
+	thy window = Sound_createGaussian (windowDuration, samplingFrequency);
+	thy bins = Sound_to_Spectrum_bins (sframe.get());
+
+	/*
+		The filters of a MelSpectrogram with y1 = f1_mel and dy = df_mel.
+	*/
+	Spectrum bins = thy bins.get();
+	const BandFilterBank_Key key { classMelSpectrogram, bins -> nx, bins -> dx, numberOfFilters, f1_mel, df_mel };
+	thy filterBank = BandFilterBank_getCached (key, [&] {
+		auto band = [&] (integer ifilter, double *fl_hz, double *fc_hz, double *fh_hz) {
+			double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+			*fc_hz = NUMmelToHertz2 (fc_mel);
+			*fl_hz = ( fc_mel - df_mel < 0.0 ? 0.0 : NUMmelToHertz2 (fc_mel - df_mel) );   // a filter below 0 mel starts at 0 Hz
+			*fh_hz = NUMmelToHertz2 (fc_mel + df_mel);
+		};
+		return BandFilterBank_create (numberOfFilters,
+			[&] (integer ifilter, integer *ifrom, integer *ito) {
+				double fl_hz, fc_hz, fh_hz;
+				band (ifilter, & fl_hz, & fc_hz, & fh_hz);
+				if (! Sampled_getWindowSamples (bins, fl_hz, fh_hz, ifrom, ito)) {
+					*ifrom = 1;
+					*ito = 0;
+				}
+			},
+			[&] (integer ifilter, integer i) {
+				// Bin with a triangular filter the power (= amplitude-squared)
+				double fl_hz, fc_hz, fh_hz;
+				band (ifilter, & fl_hz, & fc_hz, & fh_hz);
+				double f = bins -> x1 + (i - 1) * bins -> dx;
+				return NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, f);
+			}
+		);
+	});
 }
 
 autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
-		double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
-		double windowDuration = 2.0 * analysisWidth;   // Gaussian window
-		double fmin_mel = 0.0;
-		double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
-
-		// Check defaults.
-
-		if (fmax_mel <= 0.0 || fmax_mel > fceiling) {
-			fmax_mel = fceiling;
-		}
-		if (fmax_mel <= f1_mel) {
-			f1_mel = fbottom; fmax_mel = fceiling;
-		}
-		if (f1_mel <= 0.0) {
-			f1_mel = fbottom;
-		}
-		if (df_mel <= 0.0) {
-			df_mel = 100.0;
-		}
-
-		// Determine the number of filters.
-
-		integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
-		fmax_mel = f1_mel + numberOfFilters * df_mel;
-
-		integer numberOfFrames;
-		double t1;
-		Sampled_shortTermAnalysis (me, windowDuration, dt, & numberOfFrames, & t1);
-		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
-		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
-		autoMelSpectrogram thee = MelSpectrogram_create (my xmin, my xmax, numberOfFrames, dt, t1, fmin_mel, fmax_mel, numberOfFilters, df_mel, f1_mel);
+		MelAnalysis analysis;
+		Sound_initMelAnalysis (me, & analysis, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		autoMelSpectrogram thee = MelSpectrogram_create (my xmin, my xmax, analysis.numberOfFrames, dt, analysis.t1,
+			analysis.fmin_mel, analysis.fmax_mel, analysis.numberOfFilters, analysis.df_mel, analysis.f1_mel);
 
 		autoMelderProgress progress (U"MelSpectrograms analysis");
-
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			double t = Sampled_indexToX (thee.get(), iframe);
-			Sound_into_Sound (me, sframe.get(), t - windowDuration / 2.0);
-			Sounds_multiply (sframe.get(), window.get());
-			Sound_into_MelSpectrogram_frame (sframe.get(), thee.get(), iframe);
-			
-			if (iframe % 10 == 1) {
-				Melder_progress ((double) iframe / numberOfFrames, U"Frame ", iframe, U" out of ", numberOfFrames, U".");
+		Sound_into_BandFilterSpectrogram (me, thee.get(), analysis.window.get(), analysis.bins.get(),
+			[&] (MAT powerSpectra, integer firstFrame, integer lastFrame) {
+				BandFilterSpectrogram_applyFilterBank (thee.get(), *analysis.filterBank, powerSpectra, firstFrame, lastFrame);
 			}
-		}
+		);
 		
-		_Spectrogram_windowCorrection ((Spectrogram) thee.get(), window -> nx);
+		_Spectrogram_windowCorrection ((Spectrogram) thee.get(), analysis.window -> nx);
 
 		return thee;
 	} catch (MelderError) {
@@ -245,32 +431,19 @@ autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, doub
 	}
 }
 
-/*
-	Analog formant filter response :
-	H(f) = i f B / (f1^2 - f^2 + i f B)
-*/
-static int Sound_into_Spectrogram_frame (Sound me, Spectrogram thee, integer frame, double bw) {
-	Melder_assert (bw > 0);
-	autoSpectrum him = Sound_to_Spectrum_power (me);
-
-	for (integer ifilter = 1; ifilter <= thy ny; ifilter ++) {
-		double p = 0;
-		double fc = thy y1 + (ifilter - 1) * thy dy;
-		double *pow = his z [1];
-		for (integer ifreq = 1; ifreq <= his nx; ifreq ++) {
-			/*
-				H(f) = ifB / (fc^2 - f^2 + ifB)
-				H(f)| = fB / sqrt ((fc^2 - f^2)^2 + f^2B^2)
-				|H(f)|^2 = f^2B^2 / ((fc^2 - f^2)^2 + f^2B^2)
-						 = 1 / (((fc^2 - f^2) /fB)^2 + 1)
-			*/
-			double f = his x1 + (ifreq - 1) * his dx;
-			double a = NUMformantfilter_amplitude (fc, bw, f);
-			p += a * pow [ifreq];
+void Sound_getMelFilterOutputs (Sound me, Sampled thee, const MelAnalysis& analysis, MelAnalysis_FilterOutputs filterOutputs) {
+	const BandFilterBank& filterBank = *analysis.filterBank;
+	const double windowFactor = _Spectrogram_windowCorrectionFactor (analysis.window -> nx);
+	Sound_into_BandFilterSpectrogram (me, thee, analysis.window.get(), analysis.bins.get(),
+		[&] (MAT powerSpectra, integer firstFrame, integer lastFrame) {
+			autoMAT outputs = MATraw (lastFrame - firstFrame + 1, analysis.numberOfFilters);
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				for (integer ifilter = 1; ifilter <= analysis.numberOfFilters; ifilter ++)
+					outputs [iframe - firstFrame + 1] [ifilter] = filterBank.applyTo (ifilter, powerSpectra [iframe - firstFrame + 1]) / windowFactor;
+			}
+			filterOutputs (outputs.get(), firstFrame, lastFrame);
 		}
-		thy z [ifilter] [frame] = p;
-	}
-	return 1;
+	);
 }
 
 autoSpectrogram Sound_to_Spectrogram_pitchDependent (Sound me, double analysisWidth, double dt, double f1_hz, double fmax_hz, double df_hz, double relative_bw, double minimumPitch, double maximumPitch) {
@@ -299,7 +472,7 @@ autoSpectrogram Sound_Pitch_to_Spectrogram (Sound me, Pitch thee, double analysi
 	try {
 		double t1, windowDuration = 2.0 * analysisWidth; /* gaussian window */
 		double nyquist = 0.5 / my dx, samplingFrequency = 2.0 * nyquist, fmin_hz = 0.0;
-		integer numberOfFrames, numberOfUndefinedPitchFrames = 0;
+		integer numberOfFrames;
 
 		Melder_require (my xmin >= thy xmin && my xmax <= thy xmax,
 			U"The domain of the Sound should be included in the domain of the Pitch.");
@@ -334,26 +507,43 @@ autoSpectrogram Sound_Pitch_to_Spectrogram (Sound me, Pitch thee, double analysi
 
 		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
 		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
-		autoMelderProgress progress (U"Sound & Pitch: To FormantFilter");
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			double t = Sampled_indexToX (him.get(), iframe);
-			double b, f0 = Pitch_getValueAtTime (thee, t, kPitch_unit::HERTZ, 0);
+		autoSpectrum bins = Sound_to_Spectrum_bins (sframe.get());
 
-			if (isundef (f0) || f0 == 0.0) {
-				numberOfUndefinedPitchFrames ++;
-				f0 = f0_median;
-			}
-			b = relative_bw * f0;
-			Sound_into_Sound (me, sframe.get(), t - windowDuration / 2.0);
-			Sounds_multiply (sframe.get(), window.get());
-
-			Sound_into_Spectrogram_frame (sframe.get(), him.get(), iframe, b);
-
-			if (iframe % 10 == 1) {
-				Melder_progress ((double) iframe / numberOfFrames, U"Frame ", iframe, U" out of ",
-					numberOfFrames, U".");
+		/*
+			The bandwidth of the filters follows the pitch, so the filter weights differ from frame to frame.
+		*/
+		autoMelderProgress progress (U"Sound & Pitch: To FormantFilter");
+		Sound_into_BandFilterSpectrogram (me, him.get(), window.get(), bins.get(),
+			[&] (MAT powerSpectra, integer firstFrame, integer lastFrame) {
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					double t = Sampled_indexToX (him.get(), iframe);
+					double f0 = Pitch_getValueAtTime (thee, t, kPitch_unit::HERTZ, 0);
+					if (isundef (f0) || f0 == 0.0) {
+						f0 = f0_median;
+					}
+					double b = relative_bw * f0;
+					Melder_assert (b > 0);
+					const double *pow = powerSpectra [iframe - firstFrame + 1];
+					for (integer ifilter = 1; ifilter <= his ny; ifilter ++) {
+						double p = 0;
+						double fc = his y1 + (ifilter - 1) * his dy;
+						for (integer ifreq = 1; ifreq <= bins -> nx; ifreq ++) {
+							/*
+								Analog formant filter response :
+								H(f) = ifB / (fc^2 - f^2 + ifB)
+								H(f)| = fB / sqrt ((fc^2 - f^2)^2 + f^2B^2)
+								|H(f)|^2 = f^2B^2 / ((fc^2 - f^2)^2 + f^2B^2)
+										 = 1 / (((fc^2 - f^2) /fB)^2 + 1)
+							*/
+							double f = bins -> x1 + (ifreq - 1) * bins -> dx;
+							double a = NUMformantfilter_amplitude (fc, b, f);
+							p += a * pow [ifreq];
+						}
+						his z [ifilter] [iframe] = p;
+					}
+				}
 			}
-		}
+		);
 		
 		_Spectrogram_windowCorrection (him.get(), window -> nx);
 
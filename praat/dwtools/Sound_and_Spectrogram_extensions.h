@@ -26,6 +26,9 @@
 #include "Pitch.h"
 #include "Sound.h"
 
+#include <functional>
+#include <memory>
+
 autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_bark, double fmax_bark, double df_bark);
 /*
@@ -40,6 +43,30 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_mel, double fmax_mel, double df_mel);
 
+/*
+	The frames and the Mel filters of Sound_to_MelSpectrogram (with its defaults filled in),
+	for analyses that use the filter outputs of every frame but need no MelSpectrogram (see Sound_to_MFCC).
+*/
+struct BandFilterBank;
+struct MelAnalysis {
+	integer numberOfFrames, numberOfFilters;
+	double t1, fmin_mel, fmax_mel, f1_mel, df_mel;
+	autoSound window;
+	autoSpectrum bins;
+	std::shared_ptr <const BandFilterBank> filterBank;   // cached, shared with other analyses with the same bins and filters
+};
+
+void Sound_initMelAnalysis (Sound me, MelAnalysis *thee, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel);
+
+using MelAnalysis_FilterOutputs = std::function <void (constMAT outputs, integer firstFrame, integer lastFrame)>;
+void Sound_getMelFilterOutputs (Sound me, Sampled thee, const MelAnalysis& analysis, MelAnalysis_FilterOutputs filterOutputs);
+/*
+	Computes the frames 1 .. thy nx of a MelSpectrogram in blocks, in parallel,
+	and passes each block to filterOutputs, with in outputs [iframe - firstFrame + 1] [ifilter]
+	the same power as in the MelSpectrogram (i.e. after its window correction).
+	Blocks may be passed from different threads at the same time, but never overlap.
+*/
+
 autoSpectrogram Sound_to_Spectrogram_pitchDependent (Sound me, double analysisWidth,
 	double dt, double f1_hz, double fmax_hz, double df_hz, double relative_bw,
 	double minimumPitch, double maximumPitch);
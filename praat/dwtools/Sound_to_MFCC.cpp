@@ -24,11 +24,54 @@
 #include "Sound_to_MFCC.h"
 #include "Sound_and_Spectrogram_extensions.h"
 
+/*
+	Sound_to_MelSpectrogram followed by MelSpectrogram_to_MFCC, frame by frame:
+	the filter outputs of a frame go through the dB conversion of BandFilterSpectrogram
+	and the cosine transform of BandFilterSpectrogram_into_CC as soon as they are computed,
+	with the same arithmetic, so that no MelSpectrogram has to be stored.
+*/
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
-		autoMelSpectrogram mf = Sound_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
-		autoMFCC mfcc = MelSpectrogram_to_MFCC (mf.get(), numberOfCoefficients);
-		return mfcc;
+		MelAnalysis analysis;
+		Sound_initMelAnalysis (me, & analysis, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		const integer numberOfFilters = analysis.numberOfFilters;
+		if (numberOfCoefficients <= 0 || numberOfCoefficients > numberOfFilters - 1)
+			numberOfCoefficients = numberOfFilters - 1;
+		Melder_assert (numberOfCoefficients > 0);
+		// 20130220 new interpretation of maximumNumberOfCoefficients necessary for inverse transform
+		autoMFCC thee = MFCC_create (my xmin, my xmax, analysis.numberOfFrames, dt, analysis.t1,
+			numberOfFilters - 1, analysis.fmin_mel, analysis.fmax_mel);
+
+		autoNUMmatrix <double> cosinesTable (1, numberOfCoefficients + 1, 1, numberOfFilters);   // only the rows for c0 .. c [numberOfCoefficients]
+		for (integer k = 1; k <= numberOfCoefficients + 1; k ++) {
+			for (integer j = 1; j <= numberOfFilters; j ++)
+				cosinesTable [k] [j] = cos (NUMpi * (k - 1) * (j - 0.5) / numberOfFilters);
+		}
+
+		autoMelderProgress progress (U"MFCC analysis");
+		Sound_getMelFilterOutputs (me, thee.get(), analysis,
+			[&] (constMAT outputs, integer firstFrame, integer lastFrame) {
+				autoNUMvector <double> x (1, numberOfFilters);
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+						const double power = outputs [iframe - firstFrame + 1] [ifilter];
+						x [ifilter] = power > 0.0 ? 10.0 * log10 (power / 4e-10) : -300.0;   // as BandFilterSpectrogram :: v_getValueAtSample in dB
+					}
+					CC_Frame ccframe = & thy frame [iframe];
+					CC_Frame_init (ccframe, numberOfCoefficients);
+					for (integer k = 1; k <= numberOfCoefficients + 1; k ++) {
+						double y = 0.0;
+						for (integer j = 1; j <= numberOfFilters; j ++)
+							y += x [j] * cosinesTable [k] [j];
+						if (k == 1)
+							ccframe -> c0 = y;
+						else
+							ccframe -> c [k - 1] = y;
+					}
+				}
+			}
+		);
+		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no MFCC created.");
 	}
@@ -0,0 +1,56 @@
+/* LongSound_to_Intensity.cpp
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LongSound_to_Intensity.h"
+#include "Sound_to_Intensity.h"
+
+autoIntensity LongSound_to_Intensity (LongSound me, double minimumPitch, double timeStep, bool subtractMean, bool fast) {
+	try {
+		Melder_require (isdefined (minimumPitch) && minimumPitch > 0.0, U"Minimum pitch should be positive.");
+		Melder_require (isdefined (timeStep) && timeStep >= 0.0, U"Time step should be zero or positive instead of ", timeStep, U".");
+		if (timeStep == 0.0) timeStep = 0.8 / minimumPitch;   // as in Sound_to_Intensity
+
+		const double windowDuration = 6.4 / minimumPitch;
+		integer numberOfFrames;
+		double firstTime;
+		try {
+			Sampled_shortTermAnalysis (me, windowDuration, timeStep, & numberOfFrames, & firstTime);
+		} catch (MelderError) {
+			Melder_throw (U"The duration of the sound in an intensity analysis should be at least 6.4 divided by the minimum pitch (",
+				minimumPitch, U" Hz), i.e. at least ", windowDuration, U" s, instead of ", my nx * my dx, U" s.");
+		}
+		autoIntensity thee = Intensity_create (my xmin, my xmax, numberOfFrames, timeStep, firstTime);
+
+		/*
+			About a minute of frames at a time; each part of the file also contains the windows of its first and last frames.
+		*/
+		const integer numberOfFramesPerPart = std::max (integer (1), Melder_ifloor (60.0 / timeStep));
+		const double margin = 0.5 * windowDuration + 2.0 * my dx;
+		for (integer firstFrame = 1; firstFrame <= numberOfFrames; firstFrame += numberOfFramesPerPart) {
+			const integer lastFrame = std::min (firstFrame + numberOfFramesPerPart - 1, numberOfFrames);
+			autoSound part = LongSound_extractPart (me,
+				Sampled_indexToX (thee.get(), firstFrame) - margin, Sampled_indexToX (thee.get(), lastFrame) + margin, true);
+			Sound_into_Intensity (part.get(), me, thee.get(), firstFrame, lastFrame, minimumPitch, subtractMean, fast);
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": intensity analysis not performed.");
+	}
+}
+
+/* End of file LongSound_to_Intensity.cpp */
@@ -0,0 +1,28 @@
+/* LongSound_to_Intensity.h
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LongSound.h"
+#include "Intensity.h"
+
+autoIntensity LongSound_to_Intensity (LongSound me, double minimumPitch, double timeStep, bool subtractMean, bool fast);
+/*
+	The same Intensity as Sound_to_Intensity (or Sound_to_Intensity_fast) of the whole sound,
+	but computed from one part of the file at a time, so that the samples of the whole file are never in memory at once.
+*/
+
+/* End of file LongSound_to_Intensity.h */
@@ -0,0 +1,140 @@
+/* LongSound_to_Pitch.cpp
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LongSound_to_Pitch.h"
+#include "Sound_to_Pitch.h"
+
+#include <utility>
+
+#define AC_HANNING  0
+#define AC_GAUSS  1
+#define FCC_NORMAL  2
+#define FCC_ACCURATE  3
+
+/*
+	The largest absolute deviation of a sample from the mean of its channel, as computed by Sound_to_Pitch_any,
+	but reading the file block by block.
+*/
+static double LongSound_getGlobalPeak (LongSound me) {
+	constexpr integer numberOfSamplesPerBlock = 65536;
+	autoNUMmatrix <double> block (1, my numberOfChannels, 1, numberOfSamplesPerBlock);
+	autoNUMvector <longdouble> sum (1, my numberOfChannels);
+	for (integer first = 1; first <= my nx; first += numberOfSamplesPerBlock) {
+		const integer n = std::min (numberOfSamplesPerBlock, my nx - first + 1);
+		LongSound_readAudioToFloat (me, block.peek(), first, n);
+		for (integer channel = 1; channel <= my numberOfChannels; channel ++)
+			for (integer i = 1; i <= n; i ++)
+				sum [channel] += block [channel] [i];
+	}
+	double globalPeak = 0.0;
+	for (integer first = 1; first <= my nx; first += numberOfSamplesPerBlock) {
+		const integer n = std::min (numberOfSamplesPerBlock, my nx - first + 1);
+		LongSound_readAudioToFloat (me, block.peek(), first, n);
+		for (integer channel = 1; channel <= my numberOfChannels; channel ++) {
+			const double mean = double (sum [channel] / my nx);
+			for (integer i = 1; i <= n; i ++) {
+				const double value = fabs (block [channel] [i] - mean);
+				if (value > globalPeak) globalPeak = value;
+			}
+		}
+	}
+	return globalPeak;
+}
+
+void LongSound_PitchStream_init (LongSound_PitchStream me, LongSound longSound,
+	double segmentDuration, double lookahead,
+	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates, int method,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double maximumPitch)
+{
+	try {
+		Melder_require (segmentDuration > 0.0, U"The segment duration should be positive.");
+		Melder_require (lookahead >= 0.0, U"The lookahead should not be negative.");
+		Melder_assert (method >= AC_HANNING && method <= FCC_ACCURATE);
+
+		my longSound = longSound;
+		my minimumPitch = minimumPitch;
+		my periodsPerWindow = periodsPerWindow;
+		my maxnCandidates = maxnCandidates;
+		my method = method;
+		my silenceThreshold = silenceThreshold;
+		my voicingThreshold = voicingThreshold;
+		my octaveCost = octaveCost;
+		my octaveJumpCost = octaveJumpCost;
+		my voicedUnvoicedCost = voicedUnvoicedCost;
+		my maximumPitch = maximumPitch;
+
+		/*
+			The same frames as Sound_to_Pitch_any would fit in the whole sound.
+		*/
+		my dt = dt > 0.0 ? dt : periodsPerWindow / minimumPitch / 4.0;
+		const double dt_window = ( method == AC_GAUSS ? 2.0 : 1.0 ) * periodsPerWindow / minimumPitch;
+		my windowDuration = method >= FCC_NORMAL ? 1.0 / minimumPitch + dt_window : dt_window;
+		const double duration = longSound -> dx * longSound -> nx;
+		if (minimumPitch < ( method == AC_GAUSS ? 2.0 : 1.0 ) * periodsPerWindow / duration)
+			Melder_throw (U"To analyse this Sound, “minimum pitch” must not be less than ", ( method == AC_GAUSS ? 2.0 : 1.0 ) * periodsPerWindow / duration, U" Hz.");
+		try {
+			Sampled_shortTermAnalysis (longSound, my windowDuration, my dt, & my numberOfFrames, & my t1);
+		} catch (MelderError) {
+			Melder_throw (U"The pitch analysis would give zero pitch frames.");
+		}
+		my numberOfFramesPerSegment = std::max (integer (1), Melder_ifloor (segmentDuration / my dt));
+		my numberOfLookaheadFrames = Melder_iceiling (lookahead / my dt);
+		my nextFrame = 1;
+
+		my globalPeak = LongSound_getGlobalPeak (longSound);
+	} catch (MelderError) {
+		Melder_throw (longSound, U": pitch analysis not started.");
+	}
+}
+
+autoPitch LongSound_PitchStream_next (LongSound_PitchStream me) {
+	if (my nextFrame > my numberOfFrames)
+		return autoPitch ();
+	try {
+		const integer firstFrame = my nextFrame, lastFrame = std::min (firstFrame + my numberOfFramesPerSegment - 1, my numberOfFrames);
+		const integer firstAnalysedFrame = std::max (integer (1), firstFrame - my numberOfLookaheadFrames);
+		const integer lastAnalysedFrame = std::min (my numberOfFrames, lastFrame + my numberOfLookaheadFrames);
+		auto frameTime = [&] (integer iframe) { return my t1 + (iframe - 1) * my dt; };
+
+		/*
+			A whole window duration on either side is more than any frame looks at (its window, local mean, and cross-correlation span),
+			so that every frame is computed from the same samples as in the whole sound.
+		*/
+		autoSound part = LongSound_extractPart (my longSound,
+			frameTime (firstAnalysedFrame) - my windowDuration, frameTime (lastAnalysedFrame) + my windowDuration, true);
+		autoPitch analysed = Sound_to_Pitch_any (part.get(), my dt, my minimumPitch, my periodsPerWindow, my maxnCandidates, my method,
+			my silenceThreshold, my voicingThreshold, my octaveCost, my octaveJumpCost, my voicedUnvoicedCost, my maximumPitch,
+			false, my globalPeak, lastAnalysedFrame - firstAnalysedFrame + 1, frameTime (firstAnalysedFrame));
+
+		auto boundaryAfterFrame = [&] (integer iframe) { return my t1 + (iframe - 0.5) * my dt; };   // the same number at the end of a segment and the start of the next
+		const double xmin = firstFrame == 1 ? my longSound -> xmin : boundaryAfterFrame (firstFrame - 1);
+		const double xmax = lastFrame == my numberOfFrames ? my longSound -> xmax : boundaryAfterFrame (lastFrame);
+		autoPitch thee = Pitch_create (xmin, xmax, lastFrame - firstFrame + 1, my dt, frameTime (firstFrame),
+			analysed -> ceiling, analysed -> maxnCandidates);
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++)
+			std::swap (thy frame [iframe - firstFrame + 1], analysed -> frame [iframe - firstAnalysedFrame + 1]);
+
+		my nextFrame = lastFrame + 1;
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (my longSound, U": pitch of segment not computed.");
+	}
+}
+
+/* End of file LongSound_to_Pitch.cpp */
@@ -0,0 +1,61 @@
+/* LongSound_to_Pitch.h
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LongSound.h"
+#include "Pitch.h"
+
+/*
+	Pitch analysis of a LongSound, one segment of frames at a time, without reading the whole file into memory.
+
+	The frames are the same as those of Sound_to_Pitch_any on the whole sound, and so are their candidates,
+	since every segment is analysed from a part of the file that contains all the samples its frames look at,
+	and relative to the peak of the whole file.
+	The path finder, however, only sees the frames of a segment plus `lookahead` seconds of frames on both sides,
+	so the chosen path can differ from the one for the whole sound around segment boundaries
+	if there is not enough context to decide between candidates there.
+*/
+struct structLongSound_PitchStream {
+	LongSound longSound;   // not owned; should outlive the stream
+	double minimumPitch, periodsPerWindow;
+	int maxnCandidates, method;
+	double silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, maximumPitch;
+
+	double dt, t1, windowDuration, globalPeak;
+	integer numberOfFrames, numberOfFramesPerSegment, numberOfLookaheadFrames;
+	integer nextFrame;
+};
+typedef struct structLongSound_PitchStream *LongSound_PitchStream;
+
+void LongSound_PitchStream_init (LongSound_PitchStream me, LongSound longSound,
+	double segmentDuration, double lookahead,
+	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates, int method,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double maximumPitch);
+/*
+	The arguments after `lookahead` are those of Sound_to_Pitch_any.
+	Reads through the whole file once, to determine its peak.
+*/
+
+autoPitch LongSound_PitchStream_next (LongSound_PitchStream me);
+/*
+	Return value:
+		the Pitch of the next segment of frames, or an empty autoPitch after the last segment.
+		The time domains of consecutive segments are adjacent and together cover the whole LongSound.
+*/
+
+/* End of file LongSound_to_Pitch.h */
@@ -25,6 +25,7 @@
 #include "Sound.h"
 #include "Sound_extensions.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #include "enums_getText.h"
 #include "Sound_enums.h"
@@ -432,13 +433,126 @@ autoSound Sound_resample (Sound me, double samplingFrequency, integer precision)
 						(1 - fraction) * from [leftSample] + fraction * from [leftSample + 1];
 				}
 			} else {
-				for (integer i = 1; i <= numberOfSamples; i ++) {
-					double x = Sampled_indexToX (thee.get(), i);
-					double index = Sampled_xToIndex (me, x);
-					to [i] = NUM_interpolate_sinc (my z [channel], my nx, index, precision);
-				}
+				constexpr integer numberOfSamplesPerBlock = 4096;
+				MelderThread_parallelFor (numberOfSamples, numberOfSamplesPerBlock, MelderThread_getNumberOfThreads (numberOfSamples, numberOfSamplesPerBlock),
+					[&] (integer firstSample, integer lastSample, integer /* threadNumber */) {
+						for (integer i = firstSample; i <= lastSample; i ++) {
+							double x = Sampled_indexToX (thee.get(), i);
+							double index = Sampled_xToIndex (me, x);
+							to [i] = NUM_interpolate_sinc (my z [channel], my nx, index, precision);
+						}
+					}
+				);
+			}
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": not resampled.");
+	}
+}
+
+/*
+	The polyphase resampler convolves the input with a single Kaiser-windowed sinc low-pass filter,
+	evaluated at every output time. The filter is tabulated at a number of phases (fractional offsets) per input sample;
+	the filter for the offset of an output sample is linearly interpolated between the two nearest phases.
+	Every row of the table sums to 1, so that a constant signal stays constant.
+	Memory use does not depend on the length of the sound, except for the output itself,
+	and the output samples are computed in blocks, in parallel.
+*/
+autoSound Sound_resample_polyphase (Sound me, double samplingFrequency, integer numberOfZeroCrossings, double transitionWidth, integer numberOfPhasesPerZeroCrossing) {
+	try {
+		Melder_require (numberOfZeroCrossings >= 1,
+			U"The number of zero crossings should be at least 1.");
+		Melder_require (transitionWidth > 0.0 && transitionWidth < 1.0,
+			U"The transition width should be between 0 and 1.");
+		Melder_require (numberOfPhasesPerZeroCrossing >= 1,
+			U"The number of phases per zero crossing should be at least 1.");
+		const double upfactor = samplingFrequency * my dx;
+		if (fabs (upfactor - 1) < 1e-6) return Data_copy (me);
+		const integer numberOfSamples = Melder_iround ((my xmax - my xmin) * samplingFrequency);
+		if (numberOfSamples < 1)
+			Melder_throw (U"The resampled Sound would have no samples.");
+		autoSound thee = Sound_create (my ny, my xmin, my xmax, numberOfSamples, 1.0 / samplingFrequency,
+			0.5 * (my xmin + my xmax - (numberOfSamples - 1) / samplingFrequency));
+
+		/*
+			The pass band ends `transitionWidth` (as a fraction of the lower of the two Nyquist frequencies) below that Nyquist frequency,
+			and the stop band starts at it. In input samples, the filter is
+				h (t) = cutoff sinc (pi cutoff t) kaiser (t / halfWidth)
+			with the cutoff (as a fraction of the input Nyquist frequency) halfway the transition band,
+			and the Kaiser window's beta chosen for the stop-band attenuation that this length and transition width allow.
+		*/
+		const double cutoff = std::min (1.0, upfactor) * (1.0 - 0.5 * transitionWidth);
+		const double halfWidth = numberOfZeroCrossings / cutoff;   // in input samples
+		const integer numberOfTapsPerSide = Melder_iceiling (halfWidth), numberOfTaps = 2 * numberOfTapsPerSide;
+		const double attenuation = 8.0 + 2.285 * 2.0 * numberOfZeroCrossings * NUMpi * transitionWidth;   // in dB, from Kaiser's formula for the filter length
+		const double beta = attenuation > 50.0 ? 0.1102 * (attenuation - 8.7) :
+				attenuation > 21.0 ? 0.5842 * pow (attenuation - 21.0, 0.4) + 0.07886 * (attenuation - 21.0) : 0.0;
+		const double windowNormalization = 1.0 / NUMbessel_i0_f (beta);
+		/*
+			The filter is smooth on the scale of 1 / cutoff input samples, so the number of phases per input sample can shrink with the cutoff.
+		*/
+		const integer numberOfPhases = std::max (integer (2), Melder_iceiling (numberOfPhasesPerZeroCrossing * cutoff));
+		autoMAT table = MATraw (numberOfPhases + 1, numberOfTaps);   // row iphase + 1 for the fractional offset iphase / numberOfPhases
+		for (integer iphase = 0; iphase <= numberOfPhases; iphase ++) {
+			double *row = & table [iphase + 1] [1];
+			const double fraction = (double) iphase / numberOfPhases;
+			double sum = 0.0;
+			for (integer itap = 0; itap < numberOfTaps; itap ++) {
+				const double t = (itap - numberOfTapsPerSide + 1) - fraction;   // from input sample `left + itap - numberOfTapsPerSide + 1` to the output time
+				const double x = t / halfWidth, root = 1.0 - x * x;
+				const double phi = NUMpi * cutoff * t;
+				row [itap] = root <= 0.0 ? 0.0 :
+						( phi == 0.0 ? 1.0 : sin (phi) / phi ) * NUMbessel_i0_f (beta * sqrt (root)) * windowNormalization;
+				sum += row [itap];
 			}
+			for (integer itap = 0; itap < numberOfTaps; itap ++)
+				row [itap] /= sum;
 		}
+
+		constexpr integer numberOfSamplesPerBlock = 4096;
+		MelderThread_parallelFor (numberOfSamples, numberOfSamplesPerBlock, MelderThread_getNumberOfThreads (numberOfSamples, numberOfSamplesPerBlock),
+			[&] (integer firstSample, integer lastSample, integer /* threadNumber */) {
+				autoVEC filter = VECraw (numberOfTaps);
+				for (integer isample = firstSample; isample <= lastSample; isample ++) {
+					const double index = Sampled_xToIndex (me, Sampled_indexToX (thee.get(), isample));
+					const integer left = Melder_ifloor (index);
+					const double phase = (index - left) * numberOfPhases;
+					const integer iphase = std::min (Melder_ifloor (phase), numberOfPhases - 1);
+					const double weight = phase - iphase;
+					const double *row0 = & table [iphase + 1] [1], *row1 = & table [iphase + 2] [1];
+					const integer firstTap = std::max (integer (0), numberOfTapsPerSide - left);   // input samples before the first one are zero
+					const integer lastTap = std::min (numberOfTaps - 1, my nx - left + numberOfTapsPerSide - 1);   // and so are those after the last one
+					double *h = & filter [1];
+					for (integer itap = firstTap; itap <= lastTap; itap ++)
+						h [itap] = row0 [itap] + weight * (row1 [itap] - row0 [itap]);
+					/*
+						Tap `itap` reads input sample `offset + itap`, which lies in 1..nx for firstTap <= itap <= lastTap;
+						the offset itself can be less than 1, so no pointer to sample `offset` is ever formed.
+					*/
+					const integer offset = left - numberOfTapsPerSide + 1;
+					for (integer channel = 1; channel <= my ny; channel ++) {
+						const double *from = & my z [channel] [offset + firstTap];
+						const double *hFirst = & h [firstTap];
+						const integer n = lastTap - firstTap + 1;
+						/*
+							Four partial sums, so that the additions do not have to wait for each other.
+						*/
+						double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+						integer i = 0;
+						for (; i + 3 < n; i += 4) {
+							sum0 += from [i] * hFirst [i];
+							sum1 += from [i + 1] * hFirst [i + 1];
+							sum2 += from [i + 2] * hFirst [i + 2];
+							sum3 += from [i + 3] * hFirst [i + 3];
+						}
+						for (; i < n; i ++)
+							sum0 += from [i] * hFirst [i];
+						thy z [channel] [isample] = (sum0 + sum1) + (sum2 + sum3);
+					}
+				}
+			}
+		);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": not resampled.");
@@ -530,79 +644,160 @@ autoSound Sounds_concatenate (OrderedOf<structSound>& list, double overlapTime)
 	}
 }
 
+/*
+	The full linear convolution of every channel of `me` (time-reversed if `reverseMe`, which turns it into a cross-correlation)
+	with the corresponding channel of `thee`, into the channels of `him`, which has my nx + thy nx - 1 samples.
+	A sound with a single channel is combined with every channel of the other one.
+	The result consists of the plain sums of products, without any scaling.
+
+	If one sound is much shorter than the other, the longer one is cut into blocks that are each convolved
+	with the shorter one through an FFT of a few times the length of the shorter sound (overlap-save),
+	instead of transforming both sounds at once with an FFT of at least the length of the result.
+	The blocks of all channels are independent, so they are divided over the threads of the pool.
+*/
+static void Sounds_convolve_sums (Sound me, bool reverseMe, Sound thee, Sound him) {
+	const bool meIsShorter = my nx <= thy nx;
+	const Sound shortSound = meIsShorter ? me : thee, longSound = meIsShorter ? thee : me;
+	const bool reverseShort = reverseMe && meIsShorter, reverseLong = reverseMe && ! meIsShorter;
+	const integer numberOfShortSamples = shortSound -> nx, numberOfLongSamples = longSound -> nx;
+	const integer numberOfResultSamples = his nx;
+	Melder_assert (numberOfResultSamples == numberOfShortSamples + numberOfLongSamples - 1);
+
+	integer nfft = 1, nfftOfWholeResult = 1;
+	while (nfft < 4 * numberOfShortSamples) nfft *= 2;
+	while (nfftOfWholeResult < numberOfResultSamples) nfftOfWholeResult *= 2;
+	integer numberOfSamplesPerBlock = nfft - numberOfShortSamples + 1, numberOfPrecedingSamples = numberOfShortSamples - 1;
+	if (2 * nfft > nfftOfWholeResult) {   // the sounds have comparable lengths: blocks would not be any cheaper
+		nfft = nfftOfWholeResult;
+		numberOfSamplesPerBlock = numberOfResultSamples;
+		numberOfPrecedingSamples = 0;
+	}
+	const integer numberOfBlocks = (numberOfResultSamples - 1) / numberOfSamplesPerBlock + 1;
+	const integer numberOfItems = his ny * numberOfBlocks;
+
+	const integer numberOfThreads = MelderThread_getNumberOfThreads (numberOfItems, 1);
+	struct Scratch {
+		autoVEC data;
+		autoNUMfft_Table fftTable;
+	};
+	std::vector <Scratch> scratch ((size_t) numberOfThreads);
+	for (Scratch& s : scratch) {
+		s.data = VECraw (nfft);
+		NUMfft_Table_init (& s.fftTable, nfft);
+	}
+	auto multiply = [nfft] (double *data, const double *spectrum) {   // in the order of NUMfft_forward: DC, (re, im) pairs, Nyquist
+		data [1] *= spectrum [1];
+		for (integer i = 2; i < nfft; i += 2) {
+			const double re = data [i] * spectrum [i] - data [i + 1] * spectrum [i + 1];
+			data [i + 1] = data [i] * spectrum [i + 1] + data [i + 1] * spectrum [i];
+			data [i] = re;
+		}
+		if (nfft > 1)
+			data [nfft] *= spectrum [nfft];
+	};
+
+	/*
+		The spectra of the channels of the shorter sound are the same for every block.
+	*/
+	autoMAT shortSpectra = MATzero (shortSound -> ny, nfft);
+	MelderThread_parallelFor (shortSound -> ny, 1, std::min (numberOfThreads, shortSound -> ny),
+		[&] (integer firstChannel, integer lastChannel, integer ithread) {
+			for (integer channel = firstChannel; channel <= lastChannel; channel ++) {
+				const double *z = shortSound -> z [channel];
+				double *spectrum = shortSpectra [channel];
+				for (integer i = 1; i <= numberOfShortSamples; i ++)
+					spectrum [i] = z [reverseShort ? numberOfShortSamples + 1 - i : i];
+				NUMfft_forward (& scratch [(size_t) ithread - 1]. fftTable, spectrum);
+			}
+		});
+
+	/*
+		Block `iblock` of the result consists of samples firstSample .. lastSample, and is computed from the samples
+		of the longer sound from firstSample - numberOfPrecedingSamples on. Only the first numberOfPrecedingSamples
+		of the circular convolution are contaminated by wrapping around, and these are not used.
+	*/
+	MelderThread_parallelFor (numberOfItems, 1, numberOfThreads,
+		[&] (integer firstItem, integer lastItem, integer ithread) {
+			double *data = scratch [(size_t) ithread - 1]. data.at;
+			NUMfft_Table fftTable = & scratch [(size_t) ithread - 1]. fftTable;
+			for (integer item = firstItem; item <= lastItem; item ++) {
+				const integer channel = (item - 1) / numberOfBlocks + 1, iblock = (item - 1) % numberOfBlocks + 1;
+				const integer firstSample = (iblock - 1) * numberOfSamplesPerBlock + 1;
+				const integer lastSample = std::min (iblock * numberOfSamplesPerBlock, numberOfResultSamples);
+				const integer offset = firstSample - numberOfPrecedingSamples - 1;   // data [i] is sample offset + i of the longer sound
+				const double *z = longSound -> z [longSound -> ny == 1 ? 1 : channel];
+				for (integer i = 1; i <= nfft; i ++) {
+					const integer isamp = offset + i;
+					data [i] = isamp < 1 || isamp > numberOfLongSamples ? 0.0 :
+							z [reverseLong ? numberOfLongSamples + 1 - isamp : isamp];
+				}
+				NUMfft_forward (fftTable, data);
+				multiply (data, shortSpectra [shortSound -> ny == 1 ? 1 : channel]);
+				NUMfft_backward (fftTable, data);
+				double *result = his z [channel];
+				const double scale = 1.0 / nfft;
+				for (integer isamp = firstSample; isamp <= lastSample; isamp ++)
+					result [isamp] = data [isamp - offset] * scale;
+			}
+		});
+}
+
+static void Sounds_convolve_edges (Sound me, integer numberOfSamplesAtEdge, kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
+	switch (signalOutsideTimeDomain) {
+		case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
+			// do nothing
+		} break;
+		case kSounds_convolve_signalOutsideTimeDomain::SIMILAR: {
+			for (integer channel = 1; channel <= my ny; channel ++) {
+				double *a = my z [channel];
+				double edge = numberOfSamplesAtEdge;
+				for (integer i = 1; i < edge; i ++) {
+					double factor = edge / i;
+					a [i] *= factor;
+					a [my nx + 1 - i] *= factor;
+				}
+			}
+		} break;
+		//case kSounds_convolve_signalOutsideTimeDomain_PERIODIC: {
+			// do nothing
+		//} break;
+		default: Melder_fatal (U"Sounds_convolve: unimplemented outside-time-domain strategy ", (int) signalOutsideTimeDomain);
+	}
+}
+
+static void Sounds_convolve_scale (Sound me, Sound original1, Sound original2, kSounds_convolve_scaling scaling) {
+	switch (scaling) {
+		case kSounds_convolve_scaling::INTEGRAL: {
+			Vector_multiplyByScalar (me, my dx);
+		} break;
+		case kSounds_convolve_scaling::SUM: {
+			// do nothing
+		} break;
+		case kSounds_convolve_scaling::NORMALIZE: {
+			double normalizationFactor = Matrix_getNorm (original1) * Matrix_getNorm (original2);
+			if (normalizationFactor != 0.0) {
+				Vector_multiplyByScalar (me, 1.0 / normalizationFactor);
+			}
+		} break;
+		case kSounds_convolve_scaling::PEAK_099: {
+			Vector_scale (me, 0.99);
+		} break;
+		default: Melder_fatal (U"Sounds_convolve: unimplemented scaling ", (int) scaling);
+	}
+}
+
 autoSound Sounds_convolve (Sound me, Sound thee, kSounds_convolve_scaling scaling, kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
 	try {
 		if (my ny > 1 && thy ny > 1 && my ny != thy ny)
 			Melder_throw (U"The numbers of channels of the two sounds have to be equal or 1.");
 		if (my dx != thy dx)
 			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
-		integer n1 = my nx, n2 = thy nx;
-		integer n3 = n1 + n2 - 1, nfft = 1;
-		while (nfft < n3) nfft *= 2;
-		autoVEC data1 (nfft, kTensorInitializationType::RAW);
-		autoVEC data2 (nfft, kTensorInitializationType::RAW);
+		integer n1 = my nx, n2 = thy nx, n3 = n1 + n2 - 1;
 		integer numberOfChannels = my ny > thy ny ? my ny : thy ny;
 		autoSound him = Sound_create (numberOfChannels, my xmin + thy xmin, my xmax + thy xmax, n3, my dx, my x1 + thy x1);
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			double *a = my z [my ny == 1 ? 1 : channel];
-			for (integer i = n1; i > 0; i --) data1 [i] = a [i];
-			for (integer i = n1 + 1; i <= nfft; i ++) data1 [i] = 0.0;
-			a = thy z [thy ny == 1 ? 1 : channel];
-			for (integer i = n2; i > 0; i --) data2 [i] = a [i];
-			for (integer i = n2 + 1; i <= nfft; i ++) data2 [i] = 0.0;
-			NUMrealft (data1.at, nfft, 1);
-			NUMrealft (data2.at, nfft, 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
-			for (integer i = 3; i <= nfft; i += 2) {
-				double temp = data1 [i] * data2 [i] - data1 [i + 1] * data2 [i + 1];
-				data2 [i + 1] = data1 [i] * data2 [i + 1] + data1 [i + 1] * data2 [i];
-				data2 [i] = temp;
-			}
-			NUMrealft (data2.at, nfft, -1);
-			a = him -> z [channel];
-			for (integer i = 1; i <= n3; i ++) {
-				a [i] = data2 [i];
-			}
-		}
-		switch (signalOutsideTimeDomain) {
-			case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
-				// do nothing
-			} break;
-			case kSounds_convolve_signalOutsideTimeDomain::SIMILAR: {
-				for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-					double *a = his z [channel];
-					double edge = n1 < n2 ? n1 : n2;
-					for (integer i = 1; i < edge; i ++) {
-						double factor = edge / i;
-						a [i] *= factor;
-						a [n3 + 1 - i] *= factor;
-					}
-				}
-			} break;
-			//case kSounds_convolve_signalOutsideTimeDomain_PERIODIC: {
-				// do nothing
-			//} break;
-			default: Melder_fatal (U"Sounds_convolve: unimplemented outside-time-domain strategy ", (int) signalOutsideTimeDomain);
-		}
-		switch (scaling) {
-			case kSounds_convolve_scaling::INTEGRAL: {
-				Vector_multiplyByScalar (him.get(), my dx / nfft);
-			} break;
-			case kSounds_convolve_scaling::SUM: {
-				Vector_multiplyByScalar (him.get(), 1.0 / nfft);
-			} break;
-			case kSounds_convolve_scaling::NORMALIZE: {
-				double normalizationFactor = Matrix_getNorm (me) * Matrix_getNorm (thee);
-				if (normalizationFactor != 0.0) {
-					Vector_multiplyByScalar (him.get(), 1.0 / nfft / normalizationFactor);
-				}
-			} break;
-			case kSounds_convolve_scaling::PEAK_099: {
-				Vector_scale (him.get(), 0.99);
-			} break;
-			default: Melder_fatal (U"Sounds_convolve: unimplemented scaling ", (int) scaling);
-		}
+		Sounds_convolve_sums (me, false, thee, him.get());
+		Sounds_convolve_edges (him.get(), n1 < n2 ? n1 : n2, signalOutsideTimeDomain);
+		Sounds_convolve_scale (him.get(), me, thee, scaling);
 		return him;
 	} catch (MelderError) {
 		Melder_throw (me, U" & ", thee, U": not convolved.");
@@ -616,76 +811,12 @@ autoSound Sounds_crossCorrelate (Sound me, Sound thee, kSounds_convolve_scaling
 		if (my dx != thy dx)
 			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
 		integer numberOfChannels = my ny > thy ny ? my ny : thy ny;
-		integer n1 = my nx, n2 = thy nx;
-		integer n3 = n1 + n2 - 1, nfft = 1;
-		while (nfft < n3) nfft *= 2;
-		autoVEC data1 (nfft, kTensorInitializationType::RAW);
-		autoVEC data2 (nfft, kTensorInitializationType::RAW);
+		integer n1 = my nx, n2 = thy nx, n3 = n1 + n2 - 1;
 		double my_xlast = my x1 + (n1 - 1) * my dx;
 		autoSound him = Sound_create (numberOfChannels, thy xmin - my xmax, thy xmax - my xmin, n3, my dx, thy x1 - my_xlast);
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			double *a = my z [my ny == 1 ? 1 : channel];
-			for (integer i = n1; i > 0; i --) data1 [i] = a [i];
-			for (integer i = n1 + 1; i <= nfft; i ++) data1 [i] = 0.0;
-			a = thy z [thy ny == 1 ? 1 : channel];
-			for (integer i = n2; i > 0; i --) data2 [i] = a [i];
-			for (integer i = n2 + 1; i <= nfft; i ++) data2 [i] = 0.0;
-			NUMrealft (data1.at, nfft, 1);
-			NUMrealft (data2.at, nfft, 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
-			for (integer i = 3; i <= nfft; i += 2) {
-				double temp = data1 [i] * data2 [i] + data1 [i + 1] * data2 [i + 1];   // reverse me by taking the conjugate of data1
-				data2 [i + 1] = data1 [i] * data2 [i + 1] - data1 [i + 1] * data2 [i];   // reverse me by taking the conjugate of data1
-				data2 [i] = temp;
-			}
-			NUMrealft (data2.at, nfft, -1);
-			a = him -> z [channel];
-			for (integer i = 1; i < n1; i ++) {
-				a [i] = data2 [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data2
-			}
-			for (integer i = 1; i <= n2; i ++) {
-				a [i + (n1 - 1)] = data2 [i];   // data for the second part ("positive lags") is at the beginning of data2
-			}
-		}
-		switch (signalOutsideTimeDomain) {
-			case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
-				// do nothing
-			} break;
-			case kSounds_convolve_signalOutsideTimeDomain::SIMILAR: {
-				for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-					double *a = his z [channel];
-					double edge = n1 < n2 ? n1 : n2;
-					for (integer i = 1; i < edge; i ++) {
-						double factor = edge / i;
-						a [i] *= factor;
-						a [n3 + 1 - i] *= factor;
-					}
-				}
-			} break;
-			//case kSounds_convolve_signalOutsideTimeDomain_PERIODIC: {
-				// do nothing
-			//} break;
-			default: Melder_fatal (U"Sounds_crossCorrelate: unimplemented outside-time-domain strategy ", (int) signalOutsideTimeDomain);
-		}
-		switch (scaling) {
-			case kSounds_convolve_scaling::INTEGRAL: {
-				Vector_multiplyByScalar (him.get(), my dx / nfft);
-			} break;
-			case kSounds_convolve_scaling::SUM: {
-				Vector_multiplyByScalar (him.get(), 1.0 / nfft);
-			} break;
-			case kSounds_convolve_scaling::NORMALIZE: {
-				double normalizationFactor = Matrix_getNorm (me) * Matrix_getNorm (thee);
-				if (normalizationFactor != 0.0) {
-					Vector_multiplyByScalar (him.get(), 1.0 / nfft / normalizationFactor);
-				}
-			} break;
-			case kSounds_convolve_scaling::PEAK_099: {
-				Vector_scale (him.get(), 0.99);
-			} break;
-			default: Melder_fatal (U"Sounds_crossCorrelate: unimplemented scaling ", (int) scaling);
-		}
+		Sounds_convolve_sums (me, true, thee, him.get());   // the cross-correlation is the convolution with the time-reversed me
+		Sounds_convolve_edges (him.get(), n1 < n2 ? n1 : n2, signalOutsideTimeDomain);
+		Sounds_convolve_scale (him.get(), me, thee, scaling);
 		return him;
 	} catch (MelderError) {
 		Melder_throw (me, U" & ", thee, U": not cross-correlated.");
@@ -694,69 +825,12 @@ autoSound Sounds_crossCorrelate (Sound me, Sound thee, kSounds_convolve_scaling
 
 autoSound Sound_autoCorrelate (Sound me, kSounds_convolve_scaling scaling, kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
 	try {
-		integer numberOfChannels = my ny, n1 = my nx, n2 = n1 + n1 - 1, nfft = 1;
-		while (nfft < n2) nfft *= 2;
-		autoVEC data (nfft, kTensorInitializationType::RAW);
+		integer numberOfChannels = my ny, n1 = my nx, n2 = n1 + n1 - 1;
 		double my_xlast = my x1 + (n1 - 1) * my dx;
 		autoSound thee = Sound_create (numberOfChannels, my xmin - my xmax, my xmax - my xmin, n2, my dx, my x1 - my_xlast);
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			double *a = my z [channel];
-			for (integer i = n1; i > 0; i --) data [i] = a [i];
-			for (integer i = n1 + 1; i <= nfft; i ++) data [i] = 0.0;
-			NUMrealft (data.at, nfft, 1);
-			data [1] *= data [1];
-			data [2] *= data [2];
-			for (integer i = 3; i <= nfft; i += 2) {
-				data [i] = data [i] * data [i] + data [i + 1] * data [i + 1];
-				data [i + 1] = 0.0;   // reverse me by taking the conjugate of data1
-			}
-			NUMrealft (data.at, nfft, -1);
-			a = thy z [channel];
-			for (integer i = 1; i < n1; i ++) {
-				a [i] = data [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data
-			}
-			for (integer i = 1; i <= n1; i ++) {
-				a [i + (n1 - 1)] = data [i];   // data for the second part ("positive lags") is at the beginning of data
-			}
-		}
-		switch (signalOutsideTimeDomain) {
-			case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
-				// do nothing
-			} break;
-			case kSounds_convolve_signalOutsideTimeDomain::SIMILAR: {
-				for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-					double *a = thy z [channel];
-					double edge = n1;
-					for (integer i = 1; i < edge; i ++) {
-						double factor = edge / i;
-						a [i] *= factor;
-						a [n2 + 1 - i] *= factor;
-					}
-				}
-			} break;
-			//case kSounds_convolve_signalOutsideTimeDomain_PERIODIC: {
-				// do nothing
-			//} break;
-			default: Melder_fatal (U"Sounds_autoCorrelate: unimplemented outside-time-domain strategy ", (int) signalOutsideTimeDomain);
-		}
-		switch (scaling) {
-			case kSounds_convolve_scaling::INTEGRAL: {
-				Vector_multiplyByScalar (thee.get(), my dx / nfft);
-			} break;
-			case kSounds_convolve_scaling::SUM: {
-				Vector_multiplyByScalar (thee.get(), 1.0 / nfft);
-			} break;
-			case kSounds_convolve_scaling::NORMALIZE: {
-				double normalizationFactor = Matrix_getNorm (me) * Matrix_getNorm (me);
-				if (normalizationFactor != 0.0) {
-					Vector_multiplyByScalar (thee.get(), 1.0 / nfft / normalizationFactor);
-				}
-			} break;
-			case kSounds_convolve_scaling::PEAK_099: {
-				Vector_scale (thee.get(), 0.99);
-			} break;
-			default: Melder_fatal (U"Sounds_autoCorrelate: unimplemented scaling ", (int) scaling);
-		}
+		Sounds_convolve_sums (me, true, me, thee.get());
+		Sounds_convolve_edges (thee.get(), n1, signalOutsideTimeDomain);
+		Sounds_convolve_scale (thee.get(), me, me, scaling);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": autocorrelation not computed.");
@@ -117,6 +117,17 @@ autoSound Sound_resample (Sound me, double samplingFrequency, integer precision)
 		precision >= 2: sinx/x interpolation with maximum depth equal to 'precision'.
 */
 
+autoSound Sound_resample_polyphase (Sound me, double samplingFrequency, integer numberOfZeroCrossings, double transitionWidth, integer numberOfPhasesPerZeroCrossing);
+/*
+	Method:
+		convolution with a Kaiser-windowed sinc low-pass filter with `numberOfZeroCrossings` on either side,
+		tabulated at `numberOfPhasesPerZeroCrossing` fractional offsets per zero crossing.
+		The pass band ends `transitionWidth` (a fraction of the lower of the two Nyquist frequencies)
+		below the lower Nyquist frequency, where the stop band starts.
+		Longer filters and narrower transition bands are slower, but attenuate aliases more.
+		The time domain and the output sampling times are the same as with Sound_resample.
+*/
+
 autoSound Sounds_append (Sound me, double silenceDuration, Sound thee);
 /*
 	Function:
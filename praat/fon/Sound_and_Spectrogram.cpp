@@ -34,6 +34,9 @@
 
 #include "Sound_and_Spectrogram.h"
 #include "NUM2.h"
+#include "MelderThread.h"
+
+#include <atomic>
 
 #include "enums_getText.h"
 #include "Sound_and_Spectrogram_enums.h"
@@ -95,11 +98,7 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 		autoSpectrogram thee = Spectrogram_create (my xmin, my xmax, numberOfTimes, timeStep, t1,
 				0.0, fmax, numberOfFreqs, freqStep, 0.5 * (freqStep - binWidth_hertz));
 
-		autoNUMvector <double> frame (1, nsampFFT);
-		autoNUMvector <double> spec (1, nsampFFT);
 		autoNUMvector <double> window (1, nsamp_window);
-		autoNUMfft_Table fftTable;
-		NUMfft_Table_init (& fftTable, nsampFFT);
 
 		autoMelderProgress progress (U"Sound to Spectrogram...");
 		for (integer i = 1; i <= nsamp_window; i ++) {
@@ -132,52 +131,79 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 		}
 		double oneByBinWidth = 1.0 / windowssq / binWidth_samples;
 
-		for (integer iframe = 1; iframe <= numberOfTimes; iframe ++) {
-			double t = Sampled_indexToX (thee.get(), iframe);
-			integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
-			integer startSample = rightSample - halfnsamp_window;
-			integer endSample = leftSample + halfnsamp_window;
-			Melder_assert (startSample >= 1);
-			Melder_assert (endSample <= my nx);
-			for (integer i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] = 0.0;
-			}
-			for (integer channel = 1; channel <= my ny; channel ++) {
-				for (integer j = 1, i = startSample; j <= nsamp_window; j ++) {
-					frame [j] = my z [channel] [i ++] * window [j];
+		/*
+			The frames are independent, so they are divided in blocks over the threads of the pool.
+			Each thread has its own FFT table and buffers, and transforms the frames of a block back to back.
+		*/
+		constexpr integer numberOfFramesPerBlock = 16;
+		const integer numberOfThreads = MelderThread_getNumberOfThreads (numberOfTimes, numberOfFramesPerBlock);
+		struct Scratch {
+			autoNUMvector <double> frame, spec;
+			autoNUMfft_Table fftTable;
+		};
+		std::vector <Scratch> scratch ((size_t) numberOfThreads);
+		for (Scratch& s : scratch) {
+			s.frame.reset (1, nsampFFT);
+			s.spec.reset (1, nsampFFT);
+			NUMfft_Table_init (& s.fftTable, nsampFFT);
+		}
+		std::atomic <integer> numberOfFramesDone { 0 };
+		MelderThread_parallelFor (numberOfTimes, numberOfFramesPerBlock, numberOfThreads,
+			[&] (integer firstFrame, integer lastFrame, integer ithread) {
+				double *frame = scratch [(size_t) ithread - 1]. frame.peek();
+				double *spec = scratch [(size_t) ithread - 1]. spec.peek();
+				NUMfft_Table fftTable = & scratch [(size_t) ithread - 1]. fftTable;
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					double t = Sampled_indexToX (thee.get(), iframe);
+					integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
+					integer startSample = rightSample - halfnsamp_window;
+					integer endSample = leftSample + halfnsamp_window;
+					Melder_assert (startSample >= 1);
+					Melder_assert (endSample <= my nx);
+					for (integer i = 1; i <= half_nsampFFT; i ++) {
+						spec [i] = 0.0;
+					}
+					if (ithread == 1) {   // only the calling thread can talk to the user
+						const integer numberOfFramesDoneSoFar = numberOfFramesDone;
+						Melder_progress (numberOfFramesDoneSoFar / (numberOfTimes + 1.0),
+							U"Sound to Spectrogram: analysis of frame ", numberOfFramesDoneSoFar + 1, U" out of ", numberOfTimes);
+					}
+					for (integer channel = 1; channel <= my ny; channel ++) {
+						for (integer j = 1, i = startSample; j <= nsamp_window; j ++) {
+							frame [j] = my z [channel] [i ++] * window [j];
+						}
+						for (integer j = nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0f;
+
+						/*
+							Compute the Fast Fourier Transform of the frame.
+						*/
+						NUMfft_forward (fftTable, frame);   // complex spectrum
+
+						/*
+							Put the power spectrum in frame [1..half_nsampFFT + 1].
+						*/
+						spec [1] += frame [1] * frame [1];   // DC component
+						for (integer i = 2; i <= half_nsampFFT; i ++)
+							spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
+						spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
+					}
+					if (my ny > 1 ) for (integer i = 1; i <= half_nsampFFT; i ++) {
+						spec [i] /= my ny;
+					}
+
+					/*
+						Bin into frame [1..nBands].
+					*/
+					for (integer iband = 1; iband <= numberOfFreqs; iband ++) {
+						integer leftsample = (iband - 1) * binWidth_samples + 1, rightsample = leftsample + binWidth_samples;
+						long double power = 0.0;
+						for (integer i = leftsample; i < rightsample; i ++) power += spec [i];
+						thy z [iband] [iframe] = (double) power * oneByBinWidth;
+					}
+					numberOfFramesDone ++;
 				}
-				for (integer j = nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0f;
-
-				Melder_progress (iframe / (numberOfTimes + 1.0),
-					U"Sound to Spectrogram: analysis of frame ", iframe, U" out of ", numberOfTimes);
-
-				/*
-					Compute the Fast Fourier Transform of the frame.
-				*/
-				NUMfft_forward (& fftTable, frame.peek());   // complex spectrum
-
-				/*
-					Put the power spectrum in frame [1..half_nsampFFT + 1].
-				*/
-				spec [1] += frame [1] * frame [1];   // DC component
-				for (integer i = 2; i <= half_nsampFFT; i ++)
-					spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
-				spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
 			}
-			if (my ny > 1 ) for (integer i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] /= my ny;
-			}
-
-			/*
-				Bin into frame [1..nBands].
-			*/
-			for (integer iband = 1; iband <= numberOfFreqs; iband ++) {
-				integer leftsample = (iband - 1) * binWidth_samples + 1, rightsample = leftsample + binWidth_samples;
-				long double power = 0.0;
-				for (integer i = leftsample; i < rightsample; i ++) power += spec [i];
-				thy z [iband] [iframe] = (double) power * oneByBinWidth;
-			}
-		}
+		);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": spectrogram analysis not performed.");
@@ -35,13 +35,18 @@
 #include "NUM2.h"
 
 autoSpectrum Sound_to_Spectrum (Sound me, bool fast) {
+	integer numberOfSamples = my nx;
+	if (fast) {
+		numberOfSamples = 2;
+		while (numberOfSamples < my nx) numberOfSamples *= 2;
+	}
+	return Sound_to_Spectrum_padded (me, numberOfSamples);
+}
+
+autoSpectrum Sound_to_Spectrum_padded (Sound me, integer numberOfSamples) {
 	try {
-		integer numberOfSamples = my nx;
+		Melder_assert (numberOfSamples >= my nx);
 		const integer numberOfChannels = my ny;
-		if (fast) {
-			numberOfSamples = 2;
-			while (numberOfSamples < my nx) numberOfSamples *= 2;
-		}
 		integer numberOfFrequencies = numberOfSamples / 2 + 1;   // 4 samples -> cos0 cos1 sin1 cos2; 5 samples -> cos0 cos1 sin1 cos2 sin2
 
 		autoNUMvector <double> data (1, numberOfSamples);
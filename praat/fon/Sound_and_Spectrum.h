@@ -23,6 +23,14 @@ Thing_declare (Interpreter);
 autoSpectrum Sound_to_Spectrum_at (Sound me, double tim, double windowDuration, int windowType);
 
 autoSpectrum Sound_to_Spectrum (Sound me, bool fast);
+/*
+	If `fast`, the sound is padded with zeroes to a power of two.
+*/
+autoSpectrum Sound_to_Spectrum_padded (Sound me, integer numberOfSamples);
+/*
+	The sound is padded with zeroes to `numberOfSamples` (at least my nx), e.g. to NUMfft_getFastSize (my nx),
+	which is faster than no padding and takes less memory than padding to a power of two.
+*/
 autoSound Spectrum_to_Sound (Spectrum me);
 
 autoSpectrum Spectrum_lpcSmoothing (Spectrum me, int numberOfPeaks, double preemphasisFrequency);
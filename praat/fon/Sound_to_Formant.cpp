@@ -31,6 +31,10 @@
 #include "Sound_to_Formant.h"
 #include "NUM2.h"
 #include "Polynomial.h"
+#include "MelderThread.h"
+
+#include <atomic>
+#include <vector>
 
 static void burg (constVEC samples, VEC coefficients,
 	Formant_Frame frame, double nyquistFrequency, double safetyMargin)
@@ -93,16 +97,8 @@ static int findOneZero (int ijt, double vcx [], double a, double b, double *zero
 		fa = vcx [k] + a * fa;
 		fb = vcx [k] + b * fb;
 	}
-	if (fa * fb >= 0.0) {   // there should be a zero between a and b
-		Melder_casual (
-			U"There is no zero between ,", Melder_single (a),
-			U" and ", Melder_single (b),
-			U".\n    The function values are ", Melder_single (fa),
-			U" and ", Melder_single (fb),
-			U", respectively."
-		);
-		return 0;
-	}
+	if (fa * fb >= 0.0)   // there should be a zero between a and b
+		return 0;   // reported per frame, after the parallel analysis
 	do {
 		fx = 0.0;
 		/*x = fa == fb ? 0.5 * (a + b) : a + fa * (a - b) / (fb - fa);*/
@@ -138,13 +134,8 @@ static int findNewZeroes (int ijt, double ppORIG [], int degree,
 	/* Fill an array with the new zeroes, which lie between the old zeroes. */
 	newZeroes [0] = 1.0;
 	for (i = 1; i <= half_degree; i ++) {
-		if (! findOneZero (ijt, px, zeroes [i - 1], zeroes [i], & newZeroes [i])) {
-			Melder_casual (
-				U"Degree ", degree,
-				U" not completed."
-			);
+		if (! findOneZero (ijt, px, zeroes [i - 1], zeroes [i], & newZeroes [i]))
 			return 0;
-		}
 	}
 	newZeroes [half_degree + 1] = -1.0;
 	/* Grow older. */
@@ -265,7 +256,7 @@ void Formant_sort (Formant me) {
 }
 
 static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, int numberOfPoles,
-	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin, integer numberOfThreads)
 {
 	double dt = dt_in > 0.0 ? dt_in : halfdt_window / 4.0;
 	double physicalDuration = my nx * my dx, t1;
@@ -296,52 +287,78 @@ static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, int num
 		window [i] = (exp (-48.0 * (i - imid) * (i - imid) / (nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
 	}
 
+	/*
+		Every frame reads only the pre-emphasized sound and writes only its own Formant_Frame,
+		so blocks of frames can be analysed in parallel, each thread with its own buffers.
+	*/
+	constexpr integer numberOfFramesPerBlock = 8;
+	const integer maximumNumberOfThreads = MelderThread_getNumberOfThreads (nFrames, numberOfFramesPerBlock);
+	if (numberOfThreads <= 0 || numberOfThreads > maximumNumberOfThreads)
+		numberOfThreads = maximumNumberOfThreads;
 	integer maximumFrameLength = nsamp_window;
-	auto frameBuffer = VECraw (maximumFrameLength);
-	auto coefficients = VECraw (numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
-	for (integer iframe = 1; iframe <= nFrames; iframe ++) {
-		double t = Sampled_indexToX (thee.get(), iframe);
-		integer leftSample = Sampled_xToLowIndex (me, t);
-		integer rightSample = leftSample + 1;
-		integer startSample = rightSample - halfnsamp_window;
-		integer endSample = leftSample + halfnsamp_window;
-		double maximumIntensity = 0.0;
-		if (startSample < 1) startSample = 1;   // this should not be more than a rounding problem
-		if (endSample > my nx) endSample = my nx;   // this should not be more than a rounding problem
-		for (integer i = startSample; i <= endSample; i ++) {
-			double value = Sampled_getValueAtSample (me, i, Sound_LEVEL_MONO, 0);
-			if (value * value > maximumIntensity)
-				maximumIntensity = value * value;
-		}
-		thy d_frames [iframe]. intensity = maximumIntensity;
-		if (maximumIntensity == 0.0) continue;   // Burg cannot stand all zeroes
-
-		/* Copy a pre-emphasized window to a frame. */
-		const integer actualFrameLength = endSample - startSample + 1;   // should rarely be less than nsamp_window
-		VEC frame = frameBuffer.subview (1, actualFrameLength);
-		const integer offset = startSample - 1;
-		for (integer isamp = 1; isamp <= actualFrameLength; isamp ++)
-			frame [isamp] = Sampled_getValueAtSample (me, offset + isamp, Sound_LEVEL_MONO, 0) * window [isamp];
-
-		if (which == 1) {
-			burg (frame, coefficients.get(), & thy d_frames [iframe], 0.5 / my dx, safetyMargin);
-		} else if (which == 2) {
-			if (! splitLevinson (frame, numberOfPoles, & thy d_frames [iframe], 0.5 / my dx)) {
-				Melder_clearError ();
-				Melder_casual (U"(Sound_to_Formant:)"
-					U" Analysis results of frame ", iframe,
-					U" will be wrong."
-				);
+	struct Scratch { autoVEC frameBuffer, coefficients; };
+	std::vector <Scratch> scratch ((size_t) numberOfThreads);
+	for (Scratch& s : scratch) {
+		s.frameBuffer = VECraw (maximumFrameLength);
+		s.coefficients = VECraw (numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
+	}
+	std::atomic <integer> numberOfFramesDone { 0 };
+	std::vector <char> frameHasFailed ((size_t) nFrames + 1, false);   // reported afterwards, because the workers cannot talk to the user
+	MelderThread_parallelFor (nFrames, numberOfFramesPerBlock, numberOfThreads,
+		[&] (integer firstFrame, integer lastFrame, integer ithread) {
+			Scratch& s = scratch [(size_t) ithread - 1];
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				double t = Sampled_indexToX (thee.get(), iframe);
+				integer leftSample = Sampled_xToLowIndex (me, t);
+				integer rightSample = leftSample + 1;
+				integer startSample = rightSample - halfnsamp_window;
+				integer endSample = leftSample + halfnsamp_window;
+				double maximumIntensity = 0.0;
+				if (startSample < 1) startSample = 1;   // this should not be more than a rounding problem
+				if (endSample > my nx) endSample = my nx;   // this should not be more than a rounding problem
+				for (integer i = startSample; i <= endSample; i ++) {
+					double value = Sampled_getValueAtSample (me, i, Sound_LEVEL_MONO, 0);
+					if (value * value > maximumIntensity)
+						maximumIntensity = value * value;
+				}
+				thy d_frames [iframe]. intensity = maximumIntensity;
+				numberOfFramesDone ++;
+				if (maximumIntensity == 0.0) continue;   // Burg cannot stand all zeroes
+
+				/* Copy a pre-emphasized window to a frame. */
+				const integer actualFrameLength = endSample - startSample + 1;   // should rarely be less than nsamp_window
+				VEC frame = s.frameBuffer.subview (1, actualFrameLength);
+				const integer offset = startSample - 1;
+				for (integer isamp = 1; isamp <= actualFrameLength; isamp ++)
+					frame [isamp] = Sampled_getValueAtSample (me, offset + isamp, Sound_LEVEL_MONO, 0) * window [isamp];
+
+				if (which == 1) {
+					burg (frame, s.coefficients.get(), & thy d_frames [iframe], 0.5 / my dx, safetyMargin);
+				} else if (which == 2) {
+					if (! splitLevinson (frame, numberOfPoles, & thy d_frames [iframe], 0.5 / my dx)) {
+						Melder_clearError ();
+						frameHasFailed [(size_t) iframe] = true;
+					}
+				}
+				if (ithread == 1) {   // only the calling thread can talk to the user
+					const integer numberOfFramesDoneSoFar = numberOfFramesDone;
+					Melder_progress ((double) numberOfFramesDoneSoFar / (double) nFrames, U"Formant analysis: frame ", numberOfFramesDoneSoFar);
+				}
 			}
 		}
-		Melder_progress ((double) iframe / (double) nFrames, U"Formant analysis: frame ", iframe);
-	}
+	);
+	for (integer iframe = 1; iframe <= nFrames; iframe ++)
+		if (frameHasFailed [(size_t) iframe])
+			Melder_casual (U"(Sound_to_Formant:)"
+				U" Analysis results of frame ", iframe,
+				U" will be wrong."
+			);
 	Formant_sort (thee.get());
 	return thee;
 }
 
 autoFormant Sound_to_Formant_any (Sound me, double dt, int numberOfPoles, double maximumFrequency,
-	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin, integer numberOfThreads)
 {
 	double nyquist = 0.5 / my dx;
 	autoSound sound;
@@ -350,12 +367,12 @@ autoFormant Sound_to_Formant_any (Sound me, double dt, int numberOfPoles, double
 	} else {
 		sound = Sound_resample (me, maximumFrequency * 2, 50);
 	}
-	return Sound_to_Formant_any_inplace (sound.get(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
+	return Sound_to_Formant_any_inplace (sound.get(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin, numberOfThreads);
 }
 
-autoFormant Sound_to_Formant_burg (Sound me, double dt, double nFormants, double maximumFrequency, double halfdt_window, double preemphasisFrequency) {
+autoFormant Sound_to_Formant_burg (Sound me, double dt, double nFormants, double maximumFrequency, double halfdt_window, double preemphasisFrequency, integer numberOfThreads) {
 	try {
-		return Sound_to_Formant_any (me, dt, (int) (2 * nFormants), maximumFrequency, halfdt_window, 1, preemphasisFrequency, 50.0);
+		return Sound_to_Formant_any (me, dt, (int) (2 * nFormants), maximumFrequency, halfdt_window, 1, preemphasisFrequency, 50.0, numberOfThreads);
 	} catch (MelderError) {
 		Melder_throw (me, U": formant analysis (Burg) not performed.");
 	}
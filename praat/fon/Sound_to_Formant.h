@@ -20,14 +20,16 @@
 #include "Formant.h"
 
 autoFormant Sound_to_Formant_any (Sound me, double timeStep, int numberOfPoles, double maximumFrequency,
-	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin);
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin, integer numberOfThreads = 0);
 /*
 	Which = 1: Burg.
 	Which = 2: Split-Levinson
+	The frames are analysed by at most numberOfThreads threads of the MelderThread pool (0 = as many as useful);
+	the result does not depend on the number of threads.
 */
 
 autoFormant Sound_to_Formant_burg (Sound me, double timeStep, double maximumNumberOfFormants,
-	double maximumFormantFrequency, double windowLength, double preemphasisFrequency);
+	double maximumFormantFrequency, double windowLength, double preemphasisFrequency, integer numberOfThreads = 0);
 /* Throws away all formants below 50 Hz and above Nyquist minus 50 Hz. */
 
 autoFormant Sound_to_Formant_keepAll (Sound me, double timeStep, double maximumNumberOfFormants,
@@ -31,4 +31,12 @@ autoMatrix Sound_to_Harmonicity_GNE (Sound me,
 	double bandwidth,  /* 1000 Hz */
 	double step);   /* 80 Hz */
 
+autoMatrix Sound_to_Harmonicity_GNE_boundedMemory (Sound me, double fmin, double fmax, double bandwidth, double step,
+	integer maximumNumberOfBandsInMemory);
+/*
+	The same matrix as Sound_to_Harmonicity_GNE, but keeping the Hilbert envelopes of at most `maximumNumberOfBandsInMemory` bands
+	(at least 2; 0 means all) in memory at the same time, and computing the others again when they are needed,
+	so that memory use grows with the duration of the sound, but not with the number of bands.
+*/
+
 /* End of file Sound_to_Harmonicity.h */
@@ -27,36 +27,176 @@
 #include "Sound_to_Harmonicity.h"
 #include "Sound_and_LPC.h"
 #include "Sound_and_Spectrum.h"
+#include "NUM2.h"
+#include "MelderThread.h"
 
-static void bandFilter (Spectrum me, double fmid, double bandwidth) {
-	double *re = my z [1], *im = my z [2];
-	double fmin = fmid - bandwidth / 2.0, fmax = fmid + bandwidth / 2.0;
-	double twopibybandwidth = 2.0 * NUMpi / bandwidth;
-	for (integer col = 1; col <= my nx; col ++) {
-		double x = my x1 + (col - 1) * my dx;
-		if (x < fmin || x > fmax) {
-			re [col] = 0.0;
-			im [col] = 0.0;
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/*
+	The bands, their Hilbert envelopes, and the cross-correlations between those envelopes.
+	Every envelope is computed from the spectrum of the whole flattened sound, with two inverse transforms
+	in the buffers of its thread, and only for the samples within the duration of the sound
+	(the spectrum is padded to a power of two); the arithmetic is the same as that of band-filtering two copies
+	of the spectrum and converting them back into Sounds, so that the results do not depend on the number of threads,
+	nor on how many envelopes are kept in memory at the same time.
+*/
+struct GNE_Analysis {
+	Spectrum flatSpectrum;   // of the flattened sound, padded to a power of two
+	double bandwidth;
+	std::vector <double> bandCentres;
+	integer numberOfSamples;   // of each envelope
+	integer firstLag, lastLag;   // in samples, of the cross-correlations
+
+	struct Scratch {
+		autoNUMvector <double> band, hilbertBand;
+		autoNUMfft_Table fftTable;
+	};
+	std::vector <Scratch> scratch;   // one per thread
+};
+
+static void GNE_Analysis_init (GNE_Analysis *me, Spectrum flatSpectrum, double duration,
+	double fmin, double fmax, double bandwidth, double step)
+{
+	my flatSpectrum = flatSpectrum;
+	my bandwidth = bandwidth;
+	for (double fmid = fmin; fmid <= fmax; fmid += step)
+		my bandCentres.push_back (fmid);
+
+	/*
+		As in Spectrum_to_Sound and Sound_extractPart (from 0 to `duration`).
+	*/
+	const integer nfft = 2 * (flatSpectrum -> nx - 1);
+	const double samplingFrequency = nfft * flatSpectrum -> dx, dt = 1.0 / samplingFrequency, t1 = 0.5 / samplingFrequency;
+	my numberOfSamples = 1 + Melder_ifloor ((duration - t1) / dt);
+
+	/*
+		As in Sounds_crossCorrelate_short, from -0.31 to +0.31 ms.
+	*/
+	my firstLag = Melder_iceiling (-3.1e-4 / dt);
+	my lastLag = Melder_ifloor (3.1e-4 / dt);
+	Melder_assert (my lastLag >= my firstLag);
+
+	my scratch.resize ((size_t) MelderThread_getNumberOfThreads ((integer) my bandCentres.size (), 1));
+	for (GNE_Analysis::Scratch& s : my scratch) {
+		s.band.reset (1, nfft);
+		s.hilbertBand.reset (1, nfft);
+		NUMfft_Table_init (& s.fftTable, nfft);
+	}
+}
+
+/*
+	Step 3: the Hilbert envelope of one band, with its mean subtracted.
+*/
+static void GNE_Analysis_computeEnvelope (GNE_Analysis *me, integer iband, GNE_Analysis::Scratch *scratch, VEC envelope) {
+	const Spectrum spectrum = my flatSpectrum;
+	const integer nfft = 2 * (spectrum -> nx - 1);
+	const double *re = spectrum -> z [1], *im = spectrum -> z [2];
+	const double fmid = my bandCentres [(size_t) iband - 1];
+	const double fmin = fmid - my bandwidth / 2.0, fmax = fmid + my bandwidth / 2.0;
+	const double twopibybandwidth = 2.0 * NUMpi / my bandwidth;
+	const double scaling = spectrum -> dx;
+	/*
+		3a: Filter both the spectrum of the flat sound and its Hilbert transform (re = im, im = - re),
+		in the order of NUMfft_backward (cos0 cos1 sin1 ... cos(n/2)).
+	*/
+	double *band = scratch -> band.peek(), *hilbertBand = scratch -> hilbertBand.peek();
+	for (integer col = 1; col <= spectrum -> nx; col ++) {
+		const double x = spectrum -> x1 + (col - 1) * spectrum -> dx;
+		double bandRe = 0.0, bandIm = 0.0, hilbertRe = 0.0, hilbertIm = 0.0;
+		if (x >= fmin && x <= fmax) {
+			const double factor = 0.5 + 0.5 * cos (twopibybandwidth * (x - fmid));
+			bandRe = re [col] * factor * scaling;
+			bandIm = im [col] * factor * scaling;
+			hilbertRe = im [col] * factor * scaling;
+			hilbertIm = - re [col] * factor * scaling;
+		}
+		if (col == 1) {
+			band [1] = bandRe;
+			hilbertBand [1] = hilbertRe;
+		} else if (col == spectrum -> nx) {
+			band [nfft] = bandRe;
+			hilbertBand [nfft] = hilbertRe;   // the imaginary parts at the Nyquist frequency do not count
 		} else {
-			double factor = 0.5 + 0.5 * cos (twopibybandwidth * (x - fmid));
-			re [col] *= factor;
-			im [col] *= factor;
+			band [col + col - 2] = bandRe;
+			band [col + col - 1] = bandIm;
+			hilbertBand [col + col - 2] = hilbertRe;
+			hilbertBand [col + col - 1] = hilbertIm;
 		}
 	}
+	/*
+		3b: Create both the band-filtered flat sound and its Hilbert transform.
+	*/
+	NUMfft_backward (& scratch -> fftTable, band);
+	NUMfft_backward (& scratch -> fftTable, hilbertBand);
+	/*
+		3c: Compute the Hilbert envelope of the band-passed flat signal.
+	*/
+	for (integer i = 1; i <= my numberOfSamples; i ++) {
+		const double self = ( i <= nfft ? band [i] : 0.0 ), other = ( i <= nfft ? hilbertBand [i] : 0.0 );
+		envelope [i] = sqrt (self * self + other * other);
+	}
+	VECcentre_inplace (envelope);
+}
+
+/*
+	Steps 4 and 5: the maximum of the normalized cross-correlation of two envelopes,
+	with the lags summed in a single pass (but each of them in the order of Sounds_crossCorrelate_short).
+*/
+static double GNE_Analysis_getMaximumCrossCorrelation (GNE_Analysis *me, constVEC x, double xPower, constVEC y, double yPower) {
+	constexpr integer maximumNumberOfLags = 16;
+	const integer numberOfLags = my lastLag - my firstLag + 1, n = my numberOfSamples;
+	Melder_assert (numberOfLags <= maximumNumberOfLags);
+	double sum [maximumNumberOfLags] = { 0.0 };
+	/*
+		The samples of x for which y [i + lag] exists for every lag.
+	*/
+	const integer firstCommon = std::max (integer (1), 1 - my firstLag), lastCommon = std::min (n, n - my lastLag);
+	for (integer ilag = 0; ilag < numberOfLags; ilag ++) {
+		const integer lag = my firstLag + ilag;
+		for (integer i = std::max (integer (1), 1 - lag); i < firstCommon && i <= std::min (n, n - lag); i ++)
+			sum [ilag] += x [i] * y [i + lag];
+	}
+	for (integer i = firstCommon; i <= lastCommon; i ++) {
+		const double xi = x [i];
+		const double *yi = & y [i + my firstLag];
+		for (integer ilag = 0; ilag < numberOfLags; ilag ++)
+			sum [ilag] += xi * yi [ilag];
+	}
+	for (integer ilag = 0; ilag < numberOfLags; ilag ++) {
+		const integer lag = my firstLag + ilag;
+		for (integer i = std::max ({ lastCommon + 1, firstCommon, 1 - lag }); i <= std::min (n, n - lag); i ++)
+			sum [ilag] += x [i] * y [i + lag];
+	}
+	double maximum = undefined;
+	for (integer ilag = 0; ilag < numberOfLags; ilag ++) {
+		double correlation = sum [ilag];
+		if (xPower != 0.0 && yPower != 0.0)
+			correlation *= 1.0 / (sqrt (xPower) * sqrt (yPower));
+		if (ilag == 0 || correlation > maximum)
+			maximum = correlation;
+	}
+	return maximum;
+}
+
+static double getPower (constVEC x) {
+	double power = 0.0;
+	for (integer i = 1; i <= x.size; i ++)
+		power += x [i] * x [i];
+	return power;
 }
 
-autoMatrix Sound_to_Harmonicity_GNE (Sound me,
+autoMatrix Sound_to_Harmonicity_GNE_boundedMemory (Sound me,
 	double fmin,   // 500 Hz
 	double fmax,   // 4500 Hz
 	double bandwidth,  // 1000 Hz
-	double step)   // 80 Hz
+	double step,   // 80 Hz
+	integer maximumNumberOfBandsInMemory)   // 0 = all
 {
 	try {
-		autoSound envelope [1+100];
-		integer nenvelopes = Melder_ifloor ((fmax - fmin) / step);
-		for (integer ienvelope = 1; ienvelope <= 100; ienvelope ++)
-			Melder_assert (! envelope [ienvelope].get());
-
+		Melder_require (maximumNumberOfBandsInMemory == 0 || maximumNumberOfBandsInMemory >= 2,
+			U"The maximum number of bands in memory should be 0 (no limit) or at least 2.");
 		/*
 		 * Step 1: down-sampling to 10 kHz,
 		 * in order to be able to flatten the spectrum
@@ -80,84 +220,100 @@ autoMatrix Sound_to_Harmonicity_GNE (Sound me,
 		 */
 		autoLPC lpc = Sound_to_LPC_auto (original10k.get(), 13, 30e-3, 10e-3, 1e9);
 		autoSound flat = LPC_Sound_filterInverse (lpc.get(), original10k.get());
+		original10k.reset();
 		autoSpectrum flatSpectrum = Sound_to_Spectrum (flat.get(), true);
-		autoSpectrum hilbertSpectrum = Data_copy (flatSpectrum.get());
-		for (integer col = 1; col <= hilbertSpectrum -> nx; col ++) {
-			hilbertSpectrum -> z [1] [col] = flatSpectrum -> z [2] [col];
-			hilbertSpectrum -> z [2] [col] = - flatSpectrum -> z [1] [col];
-		}
-		double fmid = fmin;
-		integer ienvelope = 1;
-		autoMelderMonitor monitor (U"Computing Hilbert envelopes...");
-		while (fmid <= fmax) {
-			/*
-			 * Step 3: calculate Hilbert envelopes of bands.
-			 */
-			autoSpectrum bandSpectrum = Data_copy (flatSpectrum.get());
-			autoSpectrum hilbertBandSpectrum = Data_copy (hilbertSpectrum.get());
-			/*
-			 * 3a: Filter both the spectrum of the original flat sound and its Hilbert transform.
-			 */
-			bandFilter (bandSpectrum.get(), fmid, bandwidth);
-			bandFilter (hilbertBandSpectrum.get(), fmid, bandwidth);
-			/*
-			 * 3b: Create both the band-filtered flat sound and its Hilbert transform.
-			 */
-			autoSound band = Spectrum_to_Sound (bandSpectrum.get());
-			/*if (graphics) {
-				Graphics_beginMovieFrame (graphics, & Graphics_WHITE);
-				Spectrum_draw (bandSpectrum, graphics, 0, 5000, 0, 0, true);
-				Graphics_endMovieFrame (graphics, 0.0);
-			}*/
-			Melder_monitor (ienvelope / (nenvelopes + 1.0), U"Computing Hilbert envelope ", ienvelope, U"...");
-			autoSound hilbertBand = Spectrum_to_Sound (hilbertBandSpectrum.get());
-			envelope [ienvelope] = Sound_extractPart (band.get(), 0, duration, kSound_windowShape::RECTANGULAR, 1.0, true);
-			/*
-			 * 3c: Compute the Hilbert envelope of the band-passed flat signal.
-			 */
-			for (integer col = 1; col <= envelope [ienvelope] -> nx; col ++) {
-				double self = envelope [ienvelope] -> z [1] [col], other = hilbertBand -> z [1] [col];
-				envelope [ienvelope] -> z [1] [col] = sqrt (self * self + other * other);
-			}
-			Vector_subtractMean (envelope [ienvelope].get());
-			/*
-			 * Next band.
-			 */
-			fmid += step;
-			ienvelope += 1;
-		}
+		flat.reset();
+
+		GNE_Analysis analysis;
+		GNE_Analysis_init (& analysis, flatSpectrum.get(), duration, fmin, fmax, bandwidth, step);
+		const integer numberOfBands = (integer) analysis.bandCentres.size ();
+		autoMatrix cc = Matrix_createSimple (numberOfBands, numberOfBands);
 
 		/*
-		 * Step 4: crosscorrelation
+		 * Step 6 (beforehand): the maxima too close to the diagonal are ignored, so they are not computed.
 		 */
-		nenvelopes = ienvelope - 1;
-		autoMatrix cc = Matrix_createSimple (nenvelopes, nenvelopes);
-		for (integer row = 2; row <= nenvelopes; row ++) {
-			for (integer col = 1; col <= row - 1; col ++) {
-				autoSound crossCorrelation = Sounds_crossCorrelate_short (envelope [row].get(), envelope [col].get(), -3.1e-4, 3.1e-4, true);
-				/*
-				 * Step 5: the maximum of each correlation function
-				 */
-				double ccmax = Vector_getMaximum (crossCorrelation.get(), 0.0, 0.0, 0);
-				cc -> z [row] [col] = ccmax;
-			}
-		}
+		auto isNeeded = [=] (integer row, integer col) { return row > col && ! (labs (row - col) < bandwidth / 2.0 / step); };
 
 		/*
-		 * Step 6: maximum of the maxima, ignoring those too close to the diagonal.
-		 */	
-		for (integer row = 2; row <= nenvelopes; row ++) {
-			for (integer col = 1; col <= row - 1; col ++) {
-				if (labs (row - col) < bandwidth / 2.0 / step) {
-					cc -> z [row] [col] = 0.0;
+		 * The envelopes of a group of rows are kept in memory, while the envelopes of the groups of columns
+		 * before it are computed again; without a limit, there is a single group.
+		 */
+		const integer numberOfBandsPerGroup = ( maximumNumberOfBandsInMemory == 0 || maximumNumberOfBandsInMemory >= numberOfBands ?
+				numberOfBands : maximumNumberOfBandsInMemory / 2 );
+		const integer numberOfGroups = (numberOfBands - 1) / numberOfBandsPerGroup + 1;
+		autoMAT rowEnvelopes = MATraw (numberOfBandsPerGroup, analysis.numberOfSamples);
+		autoMAT columnEnvelopes = MATraw (numberOfGroups > 1 ? numberOfBandsPerGroup : 0, analysis.numberOfSamples);
+		autoVEC rowPowers = VECraw (numberOfBandsPerGroup), columnPowers = VECraw (numberOfBandsPerGroup);
+
+		integer numberOfEnvelopesToCompute = 0;
+		for (integer firstRow = 1; firstRow <= numberOfBands; firstRow += numberOfBandsPerGroup) {
+			const integer lastRow = std::min (firstRow + numberOfBandsPerGroup - 1, numberOfBands);
+			numberOfEnvelopesToCompute += lastRow - firstRow + 1;
+			for (integer firstColumn = 1; firstColumn < firstRow; firstColumn += numberOfBandsPerGroup)
+				if (isNeeded (lastRow, firstColumn))
+					numberOfEnvelopesToCompute += numberOfBandsPerGroup;
+		}
+		std::atomic <integer> numberOfEnvelopesComputed { 0 };
+		autoMelderMonitor monitor (U"Computing Hilbert envelopes...");
+		auto computeEnvelopes = [&] (integer firstBand, integer lastBand, MAT envelopes, VEC powers) {
+			const integer numberOfBandsInGroup = lastBand - firstBand + 1;
+			MelderThread_parallelFor (numberOfBandsInGroup, 1,
+				std::min ((integer) analysis.scratch.size (), MelderThread_getNumberOfThreads (numberOfBandsInGroup, 1)),
+				[&] (integer first, integer last, integer ithread) {
+					for (integer i = first; i <= last; i ++) {
+						if (ithread == 1)   // only the calling thread can talk to the user
+							Melder_monitor ((numberOfEnvelopesComputed + 1.0) / (numberOfEnvelopesToCompute + 1.0),
+								U"Computing Hilbert envelope ", numberOfEnvelopesComputed + 1, U"...");
+						GNE_Analysis_computeEnvelope (& analysis, firstBand + i - 1, & analysis.scratch [(size_t) ithread - 1], envelopes.row (i));
+						powers [i] = getPower (envelopes.row (i));
+						numberOfEnvelopesComputed += 1;
+					}
 				}
+			);
+		};
+
+		for (integer firstRow = 1; firstRow <= numberOfBands; firstRow += numberOfBandsPerGroup) {
+			const integer lastRow = std::min (firstRow + numberOfBandsPerGroup - 1, numberOfBands);
+			computeEnvelopes (firstRow, lastRow, rowEnvelopes.get(), rowPowers.get());
+			for (integer firstColumn = 1; firstColumn <= firstRow; firstColumn += numberOfBandsPerGroup) {
+				if (! isNeeded (lastRow, firstColumn))
+					continue;   // nor any other pair in these two groups
+				const integer lastColumn = std::min (firstColumn + numberOfBandsPerGroup - 1, numberOfBands);
+				const bool sameGroup = ( firstColumn == firstRow );
+				if (! sameGroup)
+					computeEnvelopes (firstColumn, lastColumn, columnEnvelopes.get(), columnPowers.get());
+				constMAT columns = ( sameGroup ? rowEnvelopes.get() : columnEnvelopes.get() );
+				const constVEC powers = ( sameGroup ? rowPowers.get() : columnPowers.get() );
+
+				/*
+				 * Steps 4 and 5: crosscorrelation, and the maximum of each correlation function.
+				 */
+				std::vector <std::pair <integer, integer>> pairs;
+				for (integer row = firstRow; row <= lastRow; row ++)
+					for (integer col = firstColumn; col <= lastColumn; col ++)
+						if (isNeeded (row, col))
+							pairs.emplace_back (row, col);
+				const integer numberOfPairs = (integer) pairs.size ();
+				MelderThread_parallelFor (numberOfPairs, 1, MelderThread_getNumberOfThreads (numberOfPairs, 1),
+					[&] (integer firstPair, integer lastPair, integer /* threadNumber */) {
+						for (integer ipair = firstPair; ipair <= lastPair; ipair ++) {
+							const integer row = pairs [(size_t) ipair - 1]. first, col = pairs [(size_t) ipair - 1]. second;
+							const integer irow = row - firstRow + 1, icol = col - firstColumn + 1;
+							cc -> z [row] [col] = GNE_Analysis_getMaximumCrossCorrelation (& analysis,
+								rowEnvelopes.row (irow), rowPowers [irow], columns.row (icol), powers [icol]);
+						}
+					}
+				);
 			}
 		}
-
 		return cc;
 	} catch (MelderError) {
 		Melder_throw (me, U": not converted to Harmonicity (GNE).");
 	}
 }
 
+autoMatrix Sound_to_Harmonicity_GNE (Sound me, double fmin, double fmax, double bandwidth, double step) {
+	return Sound_to_Harmonicity_GNE_boundedMemory (me, fmin, fmax, bandwidth, step, 0);
+}
+
 /* End of file Sound_to_Harmonicity_GNE.cpp */
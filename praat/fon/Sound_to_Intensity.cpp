@@ -32,8 +32,124 @@
  */
 
 #include "Sound_to_Intensity.h"
+#include "MelderThread.h"
 
-static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double timeStep, bool subtractMeanPressure) {
+/*
+	The fast version visits every sample of a window once: the mean is subtracted afterwards, by expanding
+		sum (w [i] * (x [i] - mean)^2) = sum (w [i] * x [i]^2) - 2 * mean * sum (w [i] * x [i]) + mean^2 * sum (w [i]),
+	so that the samples are not copied, and the sums are in double precision.
+	The frames are independent, so they are distributed over the threads of the pool.
+
+	This costs (window duration / time step) multiply-adds per sample and channel, i.e. 8 with the default time step.
+	Running (prefix) sums would only make this independent of the time step for a rectangular window:
+	the Kaiser window has no recursive form, and approximating it by polynomials would need prefix sums of i^k * x [i]^2,
+	which cancel catastrophically in long sounds. An FFT convolution of x^2 with the window costs a few times log2 (window length) per sample,
+	which is no less than 8 for realistic windows, and its rounding errors are relative to the loudest part of the sound,
+	which would ruin the quiet frames (-300 dB is within range). So the cost is proportional to the number of samples
+	for any fixed ratio of window duration and time step, but not for very small time steps.
+*/
+static void Sound_into_Intensity_fast (Sound me, Sampled original, integer sampleOffset, Intensity thee, integer firstFrame, integer lastFrame, const double *window, integer halfWindowSamples, bool subtractMeanPressure) {
+	constexpr integer numberOfFramesPerBlock = 64;
+	const integer numberOfFrames = lastFrame - firstFrame + 1;
+	MelderThread_parallelFor (numberOfFrames, numberOfFramesPerBlock, MelderThread_getNumberOfThreads (numberOfFrames, numberOfFramesPerBlock),
+		[&] (integer firstItem, integer lastItem, integer /* threadNumber */) {
+			for (integer iframe = firstFrame - 1 + firstItem; iframe <= firstFrame - 1 + lastItem; iframe ++) {
+				const double midTime = Sampled_indexToX (thee, iframe);
+				const integer midSample = Sampled_xToNearestIndex (original, midTime) - sampleOffset;   // time accuracy is half a sampling period
+				const integer leftSample = std::max (midSample - halfWindowSamples, integer (1));
+				const integer rightSample = std::min (midSample + halfWindowSamples, my nx);
+				const integer n = rightSample - leftSample + 1;
+				const double *w = & window [leftSample - midSample];
+				double sumxw = 0.0, sumw = 0.0;
+				for (integer channel = 1; channel <= my ny; channel ++) {
+					const double *x = & my z [channel] [leftSample];
+					/*
+						Shifting by a sample near the mean (which does not change the variance) keeps the expansion
+						from cancelling catastrophically if the mean is large compared to the deviations from it.
+					*/
+					const double shift = subtractMeanPressure ? my z [channel] [midSample] : 0.0;
+					double sumx = 0.0, sumwx = 0.0, sumwxx = 0.0, sumwChannel = 0.0;
+					for (integer i = 0; i < n; i ++) {
+						const double xi = x [i] - shift, wx = w [i] * xi;
+						sumx += xi;
+						sumwx += wx;
+						sumwxx += wx * xi;
+						sumwChannel += w [i];
+					}
+					double energy = sumwxx;
+					if (subtractMeanPressure) {
+						const double mean = sumx / n;
+						energy += mean * (mean * sumwChannel - 2.0 * sumwx);
+						if (energy < 0.0)
+							energy = 0.0;   // rounding error for a (nearly) constant signal
+					}
+					sumxw += energy;
+					sumw += sumwChannel;
+				}
+				double intensity = sumxw / sumw;
+				intensity /= 4.0e-10;
+				thy z [1] [iframe] = intensity < 1.0e-30 ? -300.0 : 10.0 * log10 (intensity);
+			}
+		}
+	);
+}
+
+void Sound_into_Intensity (Sound me, Sampled original, Intensity thee, integer firstFrame, integer lastFrame, double minimumPitch, bool subtractMeanPressure, bool fast) {
+	/*
+		The frames are centred on the nearest samples of the original sound,
+		so that rounding in the times of a part cannot make a frame choose a different sample.
+	*/
+	const integer sampleOffset = Melder_iround ((my x1 - original -> x1) / my dx);
+	const double windowDuration = 6.4 / minimumPitch;
+	Melder_assert (windowDuration > 0.0);
+	const double halfWindowDuration = 0.5 * windowDuration;
+	const integer halfWindowSamples = Melder_ifloor (halfWindowDuration / my dx);
+	autoNUMvector <double> amplitude (- halfWindowSamples, halfWindowSamples);
+	autoNUMvector <double> window (- halfWindowSamples, halfWindowSamples);
+
+	for (integer i = - halfWindowSamples; i <= halfWindowSamples; i ++) {
+		const double x = i * my dx / halfWindowDuration, root = 1 - x * x;
+		window [i] = root <= 0.0 ? 0.0 : NUMbessel_i0_f ((2.0 * NUMpi * NUMpi + 0.5) * sqrt (root));
+	}
+
+	if (fast) {
+		Sound_into_Intensity_fast (me, original, sampleOffset, thee, firstFrame, lastFrame, & window [0], halfWindowSamples, subtractMeanPressure);
+		return;
+	}
+	for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		const double midTime = Sampled_indexToX (thee, iframe);
+		const integer midSample = Sampled_xToNearestIndex (original, midTime) - sampleOffset;   // time accuracy is half a sampling period
+		integer leftSample = midSample - halfWindowSamples, rightSample = midSample + halfWindowSamples;
+		longdouble sumxw = 0.0, sumw = 0.0;
+		if (leftSample < 1) leftSample = 1;
+		if (rightSample > my nx) rightSample = my nx;
+
+		for (integer channel = 1; channel <= my ny; channel ++) {
+			for (integer i = leftSample; i <= rightSample; i ++) {
+				amplitude [i - midSample] = my z [channel] [i];
+			}
+			if (subtractMeanPressure) {
+				longdouble sum = 0.0;
+				for (integer i = leftSample; i <= rightSample; i ++) {
+					sum += amplitude [i - midSample];
+				}
+				double mean = (double) sum / (rightSample - leftSample + 1);
+				for (integer i = leftSample; i <= rightSample; i ++) {
+					amplitude [i - midSample] -= mean;
+				}
+			}
+			for (integer i = leftSample; i <= rightSample; i ++) {
+				sumxw += amplitude [i - midSample] * amplitude [i - midSample] * window [i - midSample];
+				sumw += window [i - midSample];
+			}
+		}
+		double intensity = double (sumxw / sumw);
+		intensity /= 4.0e-10;
+		thy z [1] [iframe] = intensity < 1.0e-30 ? -300.0 : 10.0 * log10 (intensity);
+	}
+}
+
+static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double timeStep, bool subtractMeanPressure, bool fast) {
 	try {
 		/*
 		 * Preconditions.
@@ -50,15 +166,6 @@ static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double
 
 		const double windowDuration = 6.4 / minimumPitch;
 		Melder_assert (windowDuration > 0.0);
-		const double halfWindowDuration = 0.5 * windowDuration;
-		const integer halfWindowSamples = Melder_ifloor (halfWindowDuration / my dx);
-		autoNUMvector <double> amplitude (- halfWindowSamples, halfWindowSamples);
-		autoNUMvector <double> window (- halfWindowSamples, halfWindowSamples);
-
-		for (integer i = - halfWindowSamples; i <= halfWindowSamples; i ++) {
-			const double x = i * my dx / halfWindowDuration, root = 1 - x * x;
-			window [i] = root <= 0.0 ? 0.0 : NUMbessel_i0_f ((2.0 * NUMpi * NUMpi + 0.5) * sqrt (root));
-		}
 
 		integer numberOfFrames;
 		double thyFirstTime;
@@ -70,37 +177,7 @@ static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double
 				U"i.e. at least ", 6.4 / minimumPitch, U" s, instead of ", my nx * my dx, U" s.");
 		}
 		autoIntensity thee = Intensity_create (my xmin, my xmax, numberOfFrames, timeStep, thyFirstTime);
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			const double midTime = Sampled_indexToX (thee.get(), iframe);
-			const integer midSample = Sampled_xToNearestIndex (me, midTime);   // time accuracy is half a sampling period
-			integer leftSample = midSample - halfWindowSamples, rightSample = midSample + halfWindowSamples;
-			longdouble sumxw = 0.0, sumw = 0.0;
-			if (leftSample < 1) leftSample = 1;
-			if (rightSample > my nx) rightSample = my nx;
-
-			for (integer channel = 1; channel <= my ny; channel ++) {
-				for (integer i = leftSample; i <= rightSample; i ++) {
-					amplitude [i - midSample] = my z [channel] [i];
-				}
-				if (subtractMeanPressure) {
-					longdouble sum = 0.0;
-					for (integer i = leftSample; i <= rightSample; i ++) {
-						sum += amplitude [i - midSample];
-					}
-					double mean = (double) sum / (rightSample - leftSample + 1);
-					for (integer i = leftSample; i <= rightSample; i ++) {
-						amplitude [i - midSample] -= mean;
-					}
-				}
-				for (integer i = leftSample; i <= rightSample; i ++) {
-					sumxw += amplitude [i - midSample] * amplitude [i - midSample] * window [i - midSample];
-					sumw += window [i - midSample];
-				}
-			}
-			double intensity = double (sumxw / sumw);
-			intensity /= 4.0e-10;
-			thy z [1] [iframe] = intensity < 1.0e-30 ? -300.0 : 10.0 * log10 (intensity);
-		}
+		Sound_into_Intensity (me, me, thee.get(), 1, numberOfFrames, minimumPitch, subtractMeanPressure, fast);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": intensity analysis not performed.");
@@ -111,12 +188,16 @@ autoIntensity Sound_to_Intensity (Sound me, double minimumPitch, double timeStep
 	const bool veryAccurate = false;
 	if (veryAccurate) {
 		autoSound up = Sound_upsample (me);   // because squaring doubles the frequency content, i.e. you get super-Nyquist components
-		return Sound_to_Intensity_ (up.get(), minimumPitch, timeStep, subtractMeanPressure);
+		return Sound_to_Intensity_ (up.get(), minimumPitch, timeStep, subtractMeanPressure, false);
 	} else {
-		return Sound_to_Intensity_ (me, minimumPitch, timeStep, subtractMeanPressure);
+		return Sound_to_Intensity_ (me, minimumPitch, timeStep, subtractMeanPressure, false);
 	}
 }
 
+autoIntensity Sound_to_Intensity_fast (Sound me, double minimumPitch, double timeStep, bool subtractMeanPressure) {
+	return Sound_to_Intensity_ (me, minimumPitch, timeStep, subtractMeanPressure, true);
+}
+
 autoIntensityTier Sound_to_IntensityTier (Sound me, double minimumPitch, double timeStep, bool subtractMean) {
 	try {
 		autoIntensity intensity = Sound_to_Intensity (me, minimumPitch, timeStep, subtractMean);
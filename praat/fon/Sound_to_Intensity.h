@@ -45,6 +45,26 @@ autoIntensity Sound_to_Intensity (Sound me, double minimumPitch, double timeStep
 		actual window duration = 64 ms;
 */
 
+autoIntensity Sound_to_Intensity_fast (Sound me, double minimumPitch, double timeStep, bool subtractMean);
+/*
+	Same as Sound_to_Intensity, but every window is read only once, with sums in double precision,
+	and the frames are analysed in parallel.
+	Performance:
+		6.4 / (minimumPitch * timeStep) multiply-adds per sample and channel, i.e. 8 with the default time step;
+		the Kaiser window cannot be applied with running sums (see Sound_to_Intensity.cpp).
+	Tolerance:
+		the result differs from that of Sound_to_Intensity by rounding errors only, i.e. by less than 1e-6 dB,
+		even if the mean of a window is 1e6 times larger than the deviations from that mean.
+*/
+
+void Sound_into_Intensity (Sound me, Sampled original, Intensity thee, integer firstFrame, integer lastFrame, double minimumPitch, bool subtractMean, bool fast);
+/*
+	Compute the frames `firstFrame` .. `lastFrame` of `thee` as Sound_to_Intensity (or Sound_to_Intensity_fast) of `original` would,
+	from a part `me` of `original` that only has to contain the samples of these frames' windows,
+	i.e. from 3.2 / `minimumPitch` plus one sampling period before the first frame until as much after the last.
+	The samples of `me` should lie on those of `original` (see LongSound_extractPart with `preserveTimes`).
+*/
+
 autoIntensityTier Sound_to_IntensityTier (Sound me, double minimumPitch, double timeStep, bool subtractMean);
 
 /* End of file Sound_to_Intensity.h */
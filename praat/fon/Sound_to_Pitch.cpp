@@ -36,18 +36,101 @@
 #include "NUM2.h"
 #include "MelderThread.h"
 
+#include <atomic>
+
 #define AC_HANNING  0
 #define AC_GAUSS  1
 #define FCC_NORMAL  2
 #define FCC_ACCURATE  3
 
+/*
+	The kernel of the fast cross-correlation:
+		products [k - 1] += sum (j = 0 .. n - 1) x [j] * x [j + k],   for k = 1 .. numberOfLags,
+	where x [0 .. n - 1 + numberOfLags] has to be available.
+	Several consecutive lags are computed at once, so every sum is still accumulated in order of j
+	and no horizontal additions are needed.
+	On x86 with GCC or Clang, the kernel is compiled with generic vectors of 4 doubles twice,
+	once for the baseline instruction set and once for AVX2 with FMA, and the version is chosen at run time.
+*/
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+	typedef double Sound_to_Pitch_v4d __attribute__ ((vector_size (32)));
+
+	static inline __attribute__ ((always_inline)) void addProducts (Sound_to_Pitch_v4d *sum, double x, const double *y) {
+		Sound_to_Pitch_v4d yy;
+		memcpy (& yy, y, sizeof yy);   // unaligned load
+		*sum += x * yy;
+	}
+
+	static inline __attribute__ ((always_inline)) void addLaggedProducts_kernel (const double *x, integer n, integer numberOfLags, double *products) {
+		typedef Sound_to_Pitch_v4d v4d;
+		integer k = 1;
+		for (; k + 15 <= numberOfLags; k += 16) {
+			v4d sum0 = { }, sum1 = { }, sum2 = { }, sum3 = { };
+			for (integer j = 0; j < n; j ++) {
+				const double *y = x + j + k;
+				addProducts (& sum0, x [j], y);
+				addProducts (& sum1, x [j], y + 4);
+				addProducts (& sum2, x [j], y + 8);
+				addProducts (& sum3, x [j], y + 12);
+			}
+			for (int i = 0; i < 4; i ++) {
+				products [k - 1 + i] += sum0 [i];
+				products [k + 3 + i] += sum1 [i];
+				products [k + 7 + i] += sum2 [i];
+				products [k + 11 + i] += sum3 [i];
+			}
+		}
+		for (; k + 3 <= numberOfLags; k += 4) {
+			v4d sum = { };
+			for (integer j = 0; j < n; j ++)
+				addProducts (& sum, x [j], x + j + k);
+			for (int i = 0; i < 4; i ++)
+				products [k - 1 + i] += sum [i];
+		}
+		for (; k <= numberOfLags; k ++) {
+			double sum = 0.0;
+			for (integer j = 0; j < n; j ++)
+				sum += x [j] * x [j + k];
+			products [k - 1] += sum;
+		}
+	}
+
+	__attribute__ ((target ("avx2,fma"))) static void addLaggedProducts_avx2 (const double *x, integer n, integer numberOfLags, double *products) {
+		addLaggedProducts_kernel (x, n, numberOfLags, products);
+	}
+
+	static void addLaggedProducts_baseline (const double *x, integer n, integer numberOfLags, double *products) {
+		addLaggedProducts_kernel (x, n, numberOfLags, products);
+	}
+
+	static void addLaggedProducts (const double *x, integer n, integer numberOfLags, double *products) {
+		static const bool haveAvx2 = [] {
+			__builtin_cpu_init ();
+			return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+		} ();
+		if (haveAvx2)
+			addLaggedProducts_avx2 (x, n, numberOfLags, products);
+		else
+			addLaggedProducts_baseline (x, n, numberOfLags, products);
+	}
+#else
+	static void addLaggedProducts (const double *x, integer n, integer numberOfLags, double *products) {
+		for (integer k = 1; k <= numberOfLags; k ++) {
+			double sum = 0.0;
+			for (integer j = 0; j < n; j ++)
+				sum += x [j] * x [j + k];
+			products [k - 1] += sum;
+		}
+	}
+#endif
+
 static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	double minimumPitch, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
 	NUMfft_Table fftTable, double dt_window, integer nsamp_window, integer halfnsamp_window,
 	integer maximumLag, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
 	integer brent_ixmax, integer brent_depth, double globalPeak,
 	double **frame, double *ac, double *window, double *windowR,
-	double *r, integer *imax, double *localMean)
+	double *r, integer *imax, double *localMean, double **span)
 {
 	integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
 	integer startSample, endSample;
@@ -110,30 +193,58 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 		if (localSpan > my nx + 1 - startSample) localSpan = my nx + 1 - startSample;
 		localMaximumLag = localSpan - nsamp_window;
 		offset = startSample - 1;
-		longdouble sumx2 = 0.0;   // sum of squares
-		for (integer channel = 1; channel <= my ny; channel ++) {
-			double *amp = my z [channel] + offset;
-			for (integer i = 1; i <= nsamp_window; i ++) {
-				double x = amp [i] - localMean [channel];
-				sumx2 += x * x;
+		if (span) {
+			/*
+				Fast version: subtract the local mean once, then use the vectorized kernel, in double precision.
+			*/
+			double sumx2 = 0.0;   // sum of squares
+			for (integer channel = 1; channel <= my ny; channel ++) {
+				double *amp = my z [channel] + offset, *x = span [channel];
+				for (integer i = 1; i <= localSpan; i ++)
+					x [i] = amp [i] - localMean [channel];
+				for (integer i = 1; i <= nsamp_window; i ++)
+					sumx2 += x [i] * x [i];
 			}
-		}
-		longdouble sumy2 = sumx2;   // at zero lag, these are still equal
-		r [0] = 1.0;
-		for (integer i = 1; i <= localMaximumLag; i ++) {
-			longdouble product = 0.0;
+			for (integer i = 1; i <= localMaximumLag; i ++)
+				r [i] = 0.0;
+			for (integer channel = 1; channel <= my ny; channel ++)
+				addLaggedProducts (& span [channel] [1], nsamp_window, localMaximumLag, & r [1]);
+			double sumy2 = sumx2;   // at zero lag, these are still equal
+			r [0] = 1.0;
+			for (integer i = 1; i <= localMaximumLag; i ++) {
+				for (integer channel = 1; channel <= my ny; channel ++) {
+					double y0 = span [channel] [i];
+					double yZ = span [channel] [i + nsamp_window];
+					sumy2 += yZ * yZ - y0 * y0;
+				}
+				r [- i] = r [i] = r [i] / sqrt (sumx2 * sumy2);
+			}
+		} else {
+			longdouble sumx2 = 0.0;   // sum of squares
 			for (integer channel = 1; channel <= my ny; channel ++) {
 				double *amp = my z [channel] + offset;
-				double y0 = amp [i] - localMean [channel];
-				double yZ = amp [i + nsamp_window] - localMean [channel];
-				sumy2 += yZ * yZ - y0 * y0;
-				for (integer j = 1; j <= nsamp_window; j ++) {
-					double x = amp [j] - localMean [channel];
-					double y = amp [i + j] - localMean [channel];
-					product += x * y;
+				for (integer i = 1; i <= nsamp_window; i ++) {
+					double x = amp [i] - localMean [channel];
+					sumx2 += x * x;
 				}
 			}
-			r [- i] = r [i] = (double) product / sqrt ((double) sumx2 * (double) sumy2);
+			longdouble sumy2 = sumx2;   // at zero lag, these are still equal
+			r [0] = 1.0;
+			for (integer i = 1; i <= localMaximumLag; i ++) {
+				longdouble product = 0.0;
+				for (integer channel = 1; channel <= my ny; channel ++) {
+					double *amp = my z [channel] + offset;
+					double y0 = amp [i] - localMean [channel];
+					double yZ = amp [i + nsamp_window] - localMean [channel];
+					sumy2 += yZ * yZ - y0 * y0;
+					for (integer j = 1; j <= nsamp_window; j ++) {
+						double x = amp [j] - localMean [channel];
+						double y = amp [i + j] - localMean [channel];
+						product += x * y;
+					}
+				}
+				r [- i] = r [i] = (double) product / sqrt ((double) sumx2 * (double) sumy2);
+			}
 		}
 	} else {
 
@@ -245,109 +356,19 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	}
 }
 
-Thing_define (Sound_into_Pitch_Args, Thing) { public:
-	Sound sound;
-	Pitch pitch;
-	integer firstFrame, lastFrame;
-	double minimumPitch;
-	int maxnCandidates, method;
-	double voicingThreshold, octaveCost, dt_window;
-	integer nsamp_window, halfnsamp_window, maximumLag, nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth;
-	double globalPeak, *window, *windowR;
-	bool isMainThread;
-	volatile int *cancelled;
-};
-
-Thing_implement (Sound_into_Pitch_Args, Thing, 0);
-
-static autoSound_into_Pitch_Args Sound_into_Pitch_Args_create (Sound sound, Pitch pitch,
-	integer firstFrame, integer lastFrame, double minimumPitch, int maxnCandidates, int method,
-	double voicingThreshold, double octaveCost,
-	double dt_window, integer nsamp_window, integer halfnsamp_window, integer maximumLag, integer nsampFFT,
-	integer nsamp_period, integer halfnsamp_period, integer brent_ixmax, integer brent_depth,
-	double globalPeak, double *window, double *windowR,
-	bool isMainThread, volatile int *cancelled)
-{
-	autoSound_into_Pitch_Args me = Thing_new (Sound_into_Pitch_Args);
-	my sound = sound;
-	my pitch = pitch;
-	my firstFrame = firstFrame;
-	my lastFrame = lastFrame;
-	my minimumPitch = minimumPitch;
-	my maxnCandidates = maxnCandidates;
-	my method = method;
-	my voicingThreshold = voicingThreshold;
-	my octaveCost = octaveCost;
-	my dt_window = dt_window;
-	my nsamp_window = nsamp_window;
-	my halfnsamp_window = halfnsamp_window;
-	my maximumLag = maximumLag;
-	my nsampFFT = nsampFFT;
-	my nsamp_period = nsamp_period;
-	my halfnsamp_period = halfnsamp_period;
-	my brent_ixmax = brent_ixmax;
-	my brent_depth = brent_depth;
-	my globalPeak = globalPeak;
-	my window = window;
-	my windowR = windowR;
-	my isMainThread = isMainThread;
-	my cancelled = cancelled;
-	return me;
-}
-
-MelderThread_MUTEX (mutex);
-bool mutex_inited;
-
-static MelderThread_RETURN_TYPE Sound_into_Pitch (Sound_into_Pitch_Args me)
-{
+struct Sound_into_Pitch_Scratch {   // one per thread
 	autoNUMfft_Table fftTable;
-	autoNUMmatrix <double> frame;
+	autoNUMmatrix <double> frame, span;
 	autoNUMvector <double> ac, r, localMean;
 	autoNUMvector <integer> imax;
-	{// scope
-		MelderThread_LOCK (mutex);
-		if (my method >= FCC_NORMAL) {   // cross-correlation
-			frame.reset (1, my sound -> ny, 1, my nsamp_window);
-		} else {   // autocorrelation
-			NUMfft_Table_init (& fftTable, my nsampFFT);
-			frame.reset (1, my sound -> ny, 1, my nsampFFT);
-			ac.reset (1, my nsampFFT);
-		}
-		r.reset (- my nsamp_window, my nsamp_window);
-		imax.reset (1, my maxnCandidates);
-		localMean.reset (1, my sound -> ny);
-		MelderThread_UNLOCK (mutex);
-	}
-	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
-		Pitch_Frame pitchFrame = & my pitch -> frame [iframe];
-		double t = Sampled_indexToX (my pitch, iframe);
-		if (my isMainThread) {
-			try {
-				Melder_progress (0.1 + 0.8 * (iframe - my firstFrame) / (my lastFrame - my firstFrame),
-					U"Sound to Pitch: analysing ", my lastFrame, U" frames");
-			} catch (MelderError) {
-				*my cancelled = 1;
-				throw;
-			}
-		} else if (*my cancelled) {
-			MelderThread_RETURN;
-		}
-		Sound_into_PitchFrame (my sound, pitchFrame, t,
-			my minimumPitch, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
-			& fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
-			my maximumLag, my nsampFFT, my nsamp_period, my halfnsamp_period,
-			my brent_ixmax, my brent_depth, my globalPeak,
-			frame.peek(), ac.peek(), my window, my windowR,
-			r.peek(), imax.peek(), localMean.peek());
-	}
-	MelderThread_RETURN;
-}
+};
 
 autoPitch Sound_to_Pitch_any (Sound me,
 	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates,
 	int method,
 	double silenceThreshold, double voicingThreshold,
-	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling)
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling,
+	bool fastCrossCorrelation, double givenGlobalPeak, integer givenNumberOfFrames, double givenT1)
 {
 	try {
 		autoNUMfft_Table fftTable;
@@ -421,8 +442,12 @@ autoPitch Sound_to_Pitch_any (Sound me,
 		 * Fit as many frames as possible symmetrically in the total duration.
 		 * We do this even for the forward cross-correlation method,
 		 * because that allows us to compare the two methods.
+		 * The caller can also choose the frames, e.g. to analyse a part of a LongSound.
 		 */
-		try {
+		if (givenNumberOfFrames > 0) {
+			numberOfFrames = givenNumberOfFrames;
+			t1 = givenT1;
+		} else try {
 			Sampled_shortTermAnalysis (me, method >= FCC_NORMAL ? 1.0 / minimumPitch + dt_window : dt_window, dt, & numberOfFrames, & t1);
 		} catch (MelderError) {
 			Melder_throw (U"The pitch analysis would give zero pitch frames.");
@@ -444,16 +469,18 @@ autoPitch Sound_to_Pitch_any (Sound me,
 		/*
 		 * Compute the global absolute peak for determination of silence threshold.
 		 */
-		globalPeak = 0.0;
-		for (integer channel = 1; channel <= my ny; channel ++) {
-			longdouble sum = 0.0;
-			for (integer i = 1; i <= my nx; i ++) {
-				sum += my z [channel] [i];
-			}
-			double mean = double (sum / my nx);
-			for (integer i = 1; i <= my nx; i ++) {
-				double value = fabs (my z [channel] [i] - mean);
-				if (value > globalPeak) globalPeak = value;
+		globalPeak = givenGlobalPeak;
+		if (globalPeak == 0.0) {
+			for (integer channel = 1; channel <= my ny; channel ++) {
+				longdouble sum = 0.0;
+				for (integer i = 1; i <= my nx; i ++) {
+					sum += my z [channel] [i];
+				}
+				double mean = double (sum / my nx);
+				for (integer i = 1; i <= my nx; i ++) {
+					double value = fabs (my z [channel] [i] - mean);
+					if (value > globalPeak) globalPeak = value;
+				}
 			}
 		}
 		if (globalPeak == 0.0) {
@@ -528,32 +555,48 @@ autoPitch Sound_to_Pitch_any (Sound me,
 
 		autoMelderProgress progress (U"Sound to Pitch...");
 
-		integer numberOfFramesPerThread = 20;
-		int numberOfThreads = (numberOfFrames - 1) / numberOfFramesPerThread + 1;
-		const int numberOfProcessors = MelderThread_getNumberOfProcessors ();
-		trace (numberOfProcessors, U" processors");
-		if (numberOfThreads > numberOfProcessors) numberOfThreads = numberOfProcessors;
-		if (numberOfThreads > 16) numberOfThreads = 16;
-		if (numberOfThreads < 1) numberOfThreads = 1;
-		numberOfFramesPerThread = (numberOfFrames - 1) / numberOfThreads + 1;
-
-		if (! mutex_inited) { MelderThread_MUTEX_INIT (mutex); mutex_inited = true; }
-		autoSound_into_Pitch_Args args [16];
-		integer firstFrame = 1, lastFrame = numberOfFramesPerThread;
-		volatile int cancelled = 0;
-		for (int ithread = 1; ithread <= numberOfThreads; ithread ++) {
-			if (ithread == numberOfThreads) lastFrame = numberOfFrames;
-			args [ithread - 1] = Sound_into_Pitch_Args_create (me, thee.get(),
-				firstFrame, lastFrame, minimumPitch, maxnCandidates, method,
-				voicingThreshold, octaveCost,
-				dt_window, nsamp_window, halfnsamp_window, maximumLag,
-				nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth,
-				globalPeak, window.peek(), windowR.peek(),
-				ithread == numberOfThreads, & cancelled);
-			firstFrame = lastFrame + 1;
-			lastFrame += numberOfFramesPerThread;
+		/*
+			Frames are handed out in blocks to the threads of the pool; every thread has its own scratch space.
+		*/
+		constexpr integer numberOfFramesPerBlock = 8;
+		const integer numberOfThreads = MelderThread_getNumberOfThreads (numberOfFrames, numberOfFramesPerBlock);
+		trace (numberOfThreads, U" threads");
+		std::vector <Sound_into_Pitch_Scratch> scratch ((size_t) numberOfThreads);
+		for (Sound_into_Pitch_Scratch& s : scratch) {
+			if (method >= FCC_NORMAL) {   // cross-correlation
+				s.frame.reset (1, my ny, 1, nsamp_window);
+				if (fastCrossCorrelation)
+					s.span.reset (1, my ny, 1, maximumLag + nsamp_window);
+			} else {   // autocorrelation
+				NUMfft_Table_init (& s.fftTable, nsampFFT);
+				s.frame.reset (1, my ny, 1, nsampFFT);
+				s.ac.reset (1, nsampFFT);
+			}
+			s.r.reset (- nsamp_window, nsamp_window);
+			s.imax.reset (1, maxnCandidates);
+			s.localMean.reset (1, my ny);
 		}
-		MelderThread_run (Sound_into_Pitch, args, numberOfThreads);
+		std::atomic <integer> numberOfFramesDone { 0 };
+		MelderThread_parallelFor (numberOfFrames, numberOfFramesPerBlock, numberOfThreads,
+			[&] (integer firstFrame, integer lastFrame, integer ithread) {
+				Sound_into_Pitch_Scratch& s = scratch [(size_t) ithread - 1];
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					if (ithread == 1)   // only the calling thread can talk to the user
+						Melder_progress (0.1 + 0.8 * numberOfFramesDone / numberOfFrames,
+							U"Sound to Pitch: analysing ", numberOfFrames, U" frames");
+					Pitch_Frame pitchFrame = & thy frame [iframe];
+					double t = Sampled_indexToX (thee.get(), iframe);
+					Sound_into_PitchFrame (me, pitchFrame, t,
+						minimumPitch, maxnCandidates, method, voicingThreshold, octaveCost,
+						& s.fftTable, dt_window, nsamp_window, halfnsamp_window,
+						maximumLag, nsampFFT, nsamp_period, halfnsamp_period,
+						brent_ixmax, brent_depth, globalPeak,
+						s.frame.peek(), s.ac.peek(), window.peek(), windowR.peek(),
+						s.r.peek(), s.imax.peek(), s.localMean.peek(), s.span.peek());
+					numberOfFramesDone ++;
+				}
+			}
+		);
 
 		Melder_progress (0.95, U"Sound to Pitch: path finder");
 		Pitch_pathFinder (thee.get(), silenceThreshold, voicingThreshold,
@@ -582,10 +625,11 @@ autoPitch Sound_to_Pitch_ac (Sound me,
 autoPitch Sound_to_Pitch_cc (Sound me,
 	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates, int accurate,
 	double silenceThreshold, double voicingThreshold,
-	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling)
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling,
+	bool fast)
 {
 	return Sound_to_Pitch_any (me, dt, minimumPitch, periodsPerWindow, maxnCandidates, 2 + accurate,
-		silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling);
+		silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, fast);
 }
 
 /* End of file Sound_to_Pitch.cpp */
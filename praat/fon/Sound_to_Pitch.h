@@ -32,7 +32,8 @@ autoPitch Sound_to_Pitch_ac (Sound me, double timeStep, double minimumPitch,
 autoPitch Sound_to_Pitch_cc (Sound me, double timeStep, double minimumPitch,
 	double periodsPerWindow, int maxnCandidates, int accurate,
 	double silenceThreshold, double voicingThreshold, double octaveCost,
-	double octaveJumpCost, double voicedUnvoicedCost, double maximumPitch);
+	double octaveJumpCost, double voicedUnvoicedCost, double maximumPitch,
+	bool fast = false);
 /* Calls Sound_to_Pitch_any with FCC method. */
 
 autoPitch Sound_to_Pitch_any (Sound me,
@@ -48,7 +49,11 @@ autoPitch Sound_to_Pitch_any (Sound me,
 	double octaveCost,         /* favours higher pitches; default 0.01 */
 	double octaveJumpCost,     /* default 0.35 */
 	double voicedUnvoicedCost, /* default 0.14 */
-	double maximumPitch);      /* (Hz) */
+	double maximumPitch,       /* (Hz) */
+	bool fastCrossCorrelation = false,   /* FCC only: double instead of extended precision, vectorized */
+	double givenGlobalPeak = 0.0,        /* > 0.0: use instead of the peak of this Sound, e.g. if it is a part of a longer sound */
+	integer givenNumberOfFrames = 0,     /* > 0: analyse these frames, starting at time givenT1, */
+	double givenT1 = 0.0);               /* instead of fitting as many frames as possible in this Sound */
 /*
 	Function:
 		acoustic periodicity analysis.
@@ -1497,6 +1497,238 @@ void binputr80 (double x, FILE *f) {
 	}
 }
 
+/*
+	Bulk versions of the above, for the arrays in Praat's binary files.
+	On little-endian IEEE machines, these read and write whole blocks of numbers at once
+	and swap their bytes in simple loops that the compiler can vectorize;
+	they give the same bytes and the same numbers as a sequence of calls to the element-wise versions.
+	On other machines, or when debugging the portable versions (Melder_debug 18 or 181), they just call those.
+*/
+
+static bool binario_hostIsLittleEndianIEEE () {
+	static const bool result = [] {
+		const double x = -2.0;
+		const float y = -2.0f;
+		uint8 xbytes [8], ybytes [4];
+		memcpy (xbytes, & x, 8);
+		memcpy (ybytes, & y, 4);
+		return sizeof (double) == 8 && sizeof (float) == 4 &&
+			xbytes [0] == 0x00 && xbytes [6] == 0x00 && xbytes [7] == 0xC0 &&
+			ybytes [0] == 0x00 && ybytes [2] == 0x00 && ybytes [3] == 0xC0;
+	} ();
+	return result;
+}
+
+static inline uint16 binario_swap16 (uint16 x) {
+	return (uint16) ((uint16) (x << 8) | (uint16) (x >> 8));
+}
+static inline uint32 binario_swap32 (uint32 x) {
+	return (x << 24) | ((x & 0x0000'FF00) << 8) | ((x >> 8) & 0x0000'FF00) | (x >> 24);
+}
+static inline uint64 binario_swap64 (uint64 x) {
+	return ((uint64) binario_swap32 ((uint32) x) << 32) | (uint64) binario_swap32 ((uint32) (x >> 32));
+}
+
+constexpr integer binario_blockSize = 4096;   // numbers per fread or fwrite into or from a buffer on the stack
+
+void bingeti16_array (FILE *f, int *x, integer n) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				x [i] = bingeti16 (f);
+			return;
+		}
+		uint16 buffer [binario_blockSize];
+		for (integer first = 0; first < n; first += binario_blockSize) {
+			const integer blockSize = std::min (binario_blockSize, n - first);
+			if (fread (buffer, sizeof (uint16), (size_t) blockSize, f) != (size_t) blockSize) readError (f, U"two bytes.");
+			for (integer i = 0; i < blockSize; i ++)
+				x [first + i] = (int16) binario_swap16 (buffer [i]);   // reinterpret sign bit
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Signed integers not read from 2 bytes each in binary file.");
+	}
+}
+
+void bingeti32_array (FILE *f, long *x, integer n) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				x [i] = bingeti32 (f);
+			return;
+		}
+		uint32 buffer [binario_blockSize];
+		for (integer first = 0; first < n; first += binario_blockSize) {
+			const integer blockSize = std::min (binario_blockSize, n - first);
+			if (fread (buffer, sizeof (uint32), (size_t) blockSize, f) != (size_t) blockSize) readError (f, U"four bytes.");
+			for (integer i = 0; i < blockSize; i ++)
+				x [first + i] = (int32) binario_swap32 (buffer [i]);
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Signed integers not read from 4 bytes each in binary file.");
+	}
+}
+
+void bingetr32_array (FILE *f, double *x, integer n) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				x [i] = bingetr32 (f);
+			return;
+		}
+		uint32 buffer [binario_blockSize];
+		for (integer first = 0; first < n; first += binario_blockSize) {
+			const integer blockSize = std::min (binario_blockSize, n - first);
+			if (fread (buffer, sizeof (uint32), (size_t) blockSize, f) != (size_t) blockSize) readError (f, U"four bytes.");
+			for (integer i = 0; i < blockSize; i ++) {
+				const uint32 bits = binario_swap32 (buffer [i]);
+				float value;
+				memcpy (& value, & bits, 4);
+				x [first + i] = (bits & 0x7F80'0000) == 0x7F80'0000 ? undefined : value;   // like bingetr32
+			}
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 4 bytes each in binary file.");
+	}
+}
+
+void bingetr64_array (FILE *f, double *x, integer n) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18 || Melder_debug == 181) {
+			for (integer i = 0; i < n; i ++)
+				x [i] = bingetr64 (f);
+			return;
+		}
+		if (fread (x, sizeof (double), (size_t) n, f) != (size_t) n) readError (f, U"eight bytes.");   // in place: same size
+		for (integer i = 0; i < n; i ++) {
+			uint64 bits;
+			memcpy (& bits, & x [i], 8);
+			bits = binario_swap64 (bits);
+			memcpy (& x [i], & bits, 8);
+			if ((bits & 0x7FF0'0000'0000'0000) == 0x7FF0'0000'0000'0000)
+				x [i] = undefined;   // like bingetr64
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 8 bytes each in binary file.");
+	}
+}
+
+void binputi16_array (const int *x, integer n, FILE *f) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				binputi16 (x [i], f);
+			return;
+		}
+		uint16 buffer [binario_blockSize];
+		for (integer first = 0; first < n; first += binario_blockSize) {
+			const integer blockSize = std::min (binario_blockSize, n - first);
+			for (integer i = 0; i < blockSize; i ++)
+				buffer [i] = binario_swap16 ((uint16) (int16) x [first + i]);   // truncate, like binputi16
+			if (fwrite (buffer, sizeof (uint16), (size_t) blockSize, f) != (size_t) blockSize) writeError (U"two bytes.");
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Signed integers not written to 2 bytes each in binary file.");
+	}
+}
+
+void binputi32_array (const long *x, integer n, FILE *f) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				binputi32 (x [i], f);
+			return;
+		}
+		uint32 buffer [binario_blockSize];
+		for (integer first = 0; first < n; first += binario_blockSize) {
+			const integer blockSize = std::min (binario_blockSize, n - first);
+			for (integer i = 0; i < blockSize; i ++)
+				buffer [i] = binario_swap32 ((uint32) (int32) x [first + i]);   // truncate, like binputi32
+			if (fwrite (buffer, sizeof (uint32), (size_t) blockSize, f) != (size_t) blockSize) writeError (U"four bytes.");
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Signed integers not written to 4 bytes each in binary file.");
+	}
+}
+
+void binputr32_array (const double *x, integer n, FILE *f) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18) {
+			for (integer i = 0; i < n; i ++)
+				binputr32 (x [i], f);
+			return;
+		}
+		uint32 buffer [binario_blockSize];
+		integer numberInBuffer = 0;
+		auto flush = [&] () {
+			if (fwrite (buffer, sizeof (uint32), (size_t) numberInBuffer, f) != (size_t) numberInBuffer) writeError (U"four bytes.");
+			numberInBuffer = 0;
+		};
+		for (integer i = 0; i < n; i ++) {
+			uint64 bits;
+			memcpy (& bits, & x [i], 8);
+			const uint32 exponent = (uint32) (bits >> 52) & 0x0000'07FF;
+			if (exponent >= 897 && exponent <= 1150) {
+				/*
+					In the range of normalized single-precision numbers, binputr32 truncates the mantissa (rather than rounding it).
+				*/
+				const uint32 result = ((uint32) (bits >> 32) & 0x8000'0000) |   // sign
+						((exponent - 896) << 23) |   // exponent, with single-precision bias
+						((uint32) (bits >> 29) & 0x007F'FFFF);   // the highest 23 bits of the mantissa
+				buffer [numberInBuffer ++] = binario_swap32 (result);
+				if (numberInBuffer == binario_blockSize)
+					flush ();
+			} else if ((bits & 0x7FFF'FFFF'FFFF'FFFF) == 0) {
+				buffer [numberInBuffer ++] = 0;   // binputr32 writes +0.0 for -0.0 as well
+				if (numberInBuffer == binario_blockSize)
+					flush ();
+			} else {
+				flush ();   // denormalized, too large, infinite or undefined: rare
+				binputr32 (x [i], f);
+			}
+		}
+		flush ();
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 4 bytes each in binary file.");
+	}
+}
+
+void binputr64_array (const double *x, integer n, FILE *f) {
+	try {
+		if (! binario_hostIsLittleEndianIEEE () || Melder_debug == 18 || Melder_debug == 181) {
+			for (integer i = 0; i < n; i ++)
+				binputr64 (x [i], f);
+			return;
+		}
+		uint64 buffer [binario_blockSize];
+		integer numberInBuffer = 0;
+		auto flush = [&] () {
+			if (fwrite (buffer, sizeof (uint64), (size_t) numberInBuffer, f) != (size_t) numberInBuffer) writeError (U"eight bytes.");
+			numberInBuffer = 0;
+		};
+		for (integer i = 0; i < n; i ++) {
+			uint64 bits;
+			memcpy (& bits, & x [i], 8);
+			const uint32 exponent = (uint32) (bits >> 52) & 0x0000'07FF;
+			if (binario_doubleIEEE8lsb || (exponent != 0 && exponent != 0x0000'07FF)) {
+				buffer [numberInBuffer ++] = binario_swap64 (bits);   // normalized numbers are written exactly
+				if (numberInBuffer == binario_blockSize)
+					flush ();
+			} else if ((bits & 0x7FFF'FFFF'FFFF'FFFF) == 0) {
+				buffer [numberInBuffer ++] = 0;   // binputr64 writes +0.0 for -0.0 as well
+				if (numberInBuffer == binario_blockSize)
+					flush ();
+			} else {
+				flush ();   // denormalized, infinite or undefined: rare
+				binputr64 (x [i], f);
+			}
+		}
+		flush ();
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 8 bytes each in binary file.");
+	}
+}
+
 dcomplex bingetc64 (FILE *f) {
 	try {
 		dcomplex result;
@@ -178,6 +178,15 @@ double bingetr80 (FILE *f);   void binputr80 (double x, FILE *f);
 	and is the native format of a `double` on 68k Macintosh.
 */
 
+void bingeti16_array (FILE *f, int *x, integer n);   void binputi16_array (const int *x, integer n, FILE *f);
+void bingeti32_array (FILE *f, long *x, integer n);   void binputi32_array (const long *x, integer n, FILE *f);
+void bingetr32_array (FILE *f, double *x, integer n);   void binputr32_array (const double *x, integer n, FILE *f);
+void bingetr64_array (FILE *f, double *x, integer n);   void binputr64_array (const double *x, integer n, FILE *f);
+/*
+	Read or write the `n` numbers x [0] .. x [n - 1] in the same format as bingeti16 etc.,
+	but faster, by reading or writing many of them at once.
+*/
+
 dcomplex bingetc64 (FILE *f);
 dcomplex bingetc128 (FILE *f);
 void binputc64 (dcomplex z, FILE *f);
@@ -19,9 +19,15 @@
 #include "melder.h"
 #include <wctype.h>
 #include <assert.h>
+#include <atomic>
 
-static int64 totalNumberOfAllocations = 0, totalNumberOfDeallocations = 0, totalAllocationSize = 0,
-	totalNumberOfMovingReallocs = 0, totalNumberOfReallocsInSitu = 0;
+/*
+	Atomic, because analyses can allocate on several threads at the same time.
+	Only the counts themselves have to be exact, so relaxed ordering would suffice,
+	but on the usual processors the default ordering costs the same for an increment.
+*/
+static std::atomic <int64> totalNumberOfAllocations { 0 }, totalNumberOfDeallocations { 0 }, totalAllocationSize { 0 },
+	totalNumberOfMovingReallocs { 0 }, totalNumberOfReallocsInSitu { 0 };
 
 /*
  * The rainy-day fund.
@@ -36,7 +36,7 @@ double strtod_c(const char *s, char **e) {
 	static auto cLocale = std::locale::classic();
 	static auto &cNumget = std::use_facet<std::num_get<char>>(cLocale);
 	static auto &cCtype = std::use_facet<std::ctype<char>>(cLocale);
-	static std::ios format(nullptr);  // Wake me up when Praat gets thread-safe. But I'd hope that that global array of buffers will also have changed by then.
+	static thread_local std::ios format(nullptr);  // One per thread, as in melder_ftoa.cpp
 	std::ios_base::iostate err = std::ios_base::goodbit;
 
 	const char *p = s;
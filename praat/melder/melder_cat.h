@@ -20,8 +20,8 @@
 
 namespace MelderCat {
 	constexpr int _k_NUMBER_OF_BUFFERS = 33;
-	extern MelderString _buffers [_k_NUMBER_OF_BUFFERS];
-	extern int _bufferNumber;
+	extern thread_local MelderString _buffers [_k_NUMBER_OF_BUFFERS];   // Parselmouth: per thread
+	extern thread_local int _bufferNumber;
 };
 
 template <typename... Args>
@@ -32,7 +32,7 @@ struct array_ostreambuf : public std::streambuf {
 bool sftoa_c(char *s, size_t n, double value, unsigned char precision, std::ios_base::fmtflags floatflags = std::ios_base::fmtflags(0)) {
 	static auto cLocale = std::locale::classic();
 	static auto &cNumput = std::use_facet<std::num_put<char>>(cLocale);
-	static std::ios format(nullptr);  // Wake me up when Praat gets thread-safe. But I'd hope that that global array of buffers will also have changed by then.
+	static thread_local std::ios format(nullptr);  // One per thread, just like the global array of buffers below.
 
 	array_ostreambuf buffer(s, n);
 	format.precision(precision);
@@ -60,9 +60,10 @@ inline bool sftoa_c(char (&s)[N], double value, unsigned char precision, std::io
 #define MAXIMUM_NUMERIC_STRING_LENGTH  800
 	/* = sign + 324 + point + 60 + e + sign + 3 + null byte + ("·10^^" - "e"), times 2, + i, + 7 extra */
 
-static char   buffers8  [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
-static char32 buffers32 [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
-static int ibuffer = 0;
+/* Parselmouth: thread-local, so that concurrent analyses can format numbers into their error messages. */
+static thread_local char   buffers8  [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
+static thread_local char32 buffers32 [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
+static thread_local int ibuffer = 0;
 
 #define CONVERT_BUFFER_TO_CHAR32 \
 	char32 *q = buffers32 [ibuffer]; \
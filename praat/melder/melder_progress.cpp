@@ -38,7 +38,7 @@ void MelderProgress::_doProgress (double progress, conststring32 message) {
 		MelderProgress::_p_progressProc (progress, message);
 }
 
-MelderString MelderProgress::_buffer = { 0, 0, nullptr };
+thread_local MelderString MelderProgress::_buffer = { 0, 0, nullptr };
 
 void * MelderProgress::_doMonitor (double progress, conststring32 message) {
 	if (! Melder_batch && MelderProgress::_depth >= 0) {
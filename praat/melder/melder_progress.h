@@ -105,7 +105,7 @@ namespace MelderProgress {
 	extern MonitorProc _p_monitorProc;
 	void _doProgress (double progress, conststring32 message);
 	void * _doMonitor (double progress, conststring32 message);
-	extern MelderString _buffer;
+	extern thread_local MelderString _buffer;   // Parselmouth: per thread, as concurrent analyses report progress
 }
 
 void Melder_progressOff ();
@@ -18,9 +18,10 @@
 
 #include "melder.h"
 #include "../kar/UnicodeData.h"
+#include <atomic>
 #define FREE_THRESHOLD_BYTES 10000LL
 
-static int64 totalNumberOfAllocations = 0, totalNumberOfDeallocations = 0, totalAllocationSize = 0, totalDeallocationSize = 0;
+static std::atomic <int64> totalNumberOfAllocations { 0 }, totalNumberOfDeallocations { 0 }, totalAllocationSize { 0 }, totalDeallocationSize { 0 };   // atomic, as in melder_alloc.cpp
 
 void MelderString16_free (MelderString16 *me) {
 	if (! my string) return;
@@ -179,7 +180,7 @@ int64 MelderString_deallocationSize () {
 	return totalDeallocationSize;
 }
 
-MelderString MelderCat::_buffers [MelderCat::_k_NUMBER_OF_BUFFERS] { };
-int MelderCat::_bufferNumber = 0;
+thread_local MelderString MelderCat::_buffers [MelderCat::_k_NUMBER_OF_BUFFERS] { };
+thread_local int MelderCat::_bufferNumber = 0;
 
 /* End of file melder_strings.cpp */
@@ -17,8 +17,9 @@
  */
 
 #include "melder.h"
+#include <atomic>
 
-static integer theTotalNumberOfArrays;
+static std::atomic <integer> theTotalNumberOfArrays { 0 };   // atomic, as in melder_alloc.cpp
 
 integer NUM_getTotalNumberOfArrays () { return theTotalNumberOfArrays; }
 
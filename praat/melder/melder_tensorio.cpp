@@ -20,6 +20,28 @@
 
 /*** Typed I/O functions for vectors and matrices. ***/
 
+/*
+	The binary versions read and write whole rows at once,
+	with the bulk functions from abcio where these exist, and element by element otherwise.
+*/
+#define ELEMENTWISE(type,storage)  \
+	static void binget##storage##_array (FILE *f, type *x, integer n) { \
+		for (integer i = 0; i < n; i ++) \
+			x [i] = binget##storage (f); \
+	} \
+	static void binput##storage##_array (const type *x, integer n, FILE *f) { \
+		for (integer i = 0; i < n; i ++) \
+			binput##storage (x [i], f); \
+	}
+ELEMENTWISE (signed char, i8)
+ELEMENTWISE (integer, integer32BE)
+ELEMENTWISE (unsigned char, u8)
+ELEMENTWISE (unsigned int, u16)
+ELEMENTWISE (unsigned long, u32)
+ELEMENTWISE (dcomplex, c64)
+ELEMENTWISE (dcomplex, c128)
+#undef ELEMENTWISE
+
 #define FUNCTION(type,storage)  \
 	void NUMvector_writeText_##storage (const type *v, integer lo, integer hi, MelderFile file, conststring32 name) { \
 		texputintro (file, name, U" []: ", hi >= lo ? nullptr : U"(empty)", 0,0,0); \
@@ -29,8 +51,8 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void NUMvector_writeBinary_##storage (const type *v, integer lo, integer hi, FILE *f) { \
-		for (integer i = lo; i <= hi; i ++) \
-			binput##storage (v [i], f); \
+		if (hi >= lo) \
+			binput##storage##_array (& v [lo], hi - lo + 1, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	type * NUMvector_readText_##storage (integer lo, integer hi, MelderReadText text, const char *name) { \
@@ -54,9 +76,7 @@
 		type *result = nullptr; \
 		try { \
 			result = NUMvector <type> (lo, hi); \
-			for (integer i = lo; i <= hi; i ++) { \
-				result [i] = binget##storage (f); \
-			} \
+			binget##storage##_array (f, & result [lo], hi - lo + 1); \
 			return result; \
 		} catch (MelderError) { \
 			NUMvector_free (result, lo); \
@@ -79,10 +99,8 @@
 	} \
 	void NUMmatrix_writeBinary_##storage (type **m, integer row1, integer row2, integer col1, integer col2, FILE *f) { \
 		if (row2 >= row1) { \
-			for (integer irow = row1; irow <= row2; irow ++) { \
-				for (integer icol = col1; icol <= col2; icol ++) \
-					binput##storage (m [irow] [icol], f); \
-			} \
+			for (integer irow = row1; irow <= row2; irow ++) \
+				binput##storage##_array (& m [irow] [col1], col2 - col1 + 1, f);   /* the rows need not be contiguous */ \
 		} \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
@@ -107,8 +125,7 @@
 		type **result = nullptr; \
 		try { \
 			result = NUMmatrix <type> (row1, row2, col1, col2); \
-			for (integer irow = row1; irow <= row2; irow ++) for (integer icol = col1; icol <= col2; icol ++) \
-				result [irow] [icol] = binget##storage (f); \
+			binget##storage##_array (f, & result [row1] [col1], (row2 - row1 + 1) * (col2 - col1 + 1));   /* NUMmatrix rows are contiguous */ \
 			return result; \
 		} catch (MelderError) { \
 			NUMmatrix_free (result, row1, col1); \
@@ -0,0 +1,325 @@
+/* MelderThread.cpp
+ *
+ * Copyright (C) 2019 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MelderThread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined (__linux__)
+	#include <sched.h>
+#endif
+
+/*
+	Containers usually limit the CPU time of a process through a cgroup quota rather than through its affinity,
+	so that all processors of the host remain visible. Returns 0 if there is no such limit.
+*/
+static integer getCgroupLimitOnNumberOfProcessors () {
+	#if defined (__linux__)
+		double quota = -1.0, period = 0.0;
+		std::ifstream cpuMax ("/sys/fs/cgroup/cpu.max");   // cgroup v2: "max 100000" or, e.g., "200000 100000"
+		std::string quotaString;
+		if (cpuMax >> quotaString >> period) {
+			if (quotaString != "max")
+				quota = strtod (quotaString.c_str (), nullptr);
+		} else {
+			std::ifstream quotaFile ("/sys/fs/cgroup/cpu/cpu.cfs_quota_us"), periodFile ("/sys/fs/cgroup/cpu/cpu.cfs_period_us");   // cgroup v1; -1 if unlimited
+			if (! (quotaFile >> quota && periodFile >> period))
+				quota = -1.0;
+		}
+		if (quota > 0.0 && period > 0.0)
+			return std::max (integer (1), (integer) ceil (quota / period));
+	#endif
+	return 0;
+}
+
+integer MelderThread_getNumberOfProcessors () {
+	static const integer numberOfProcessors = [] {
+		integer number = (integer) std::thread::hardware_concurrency ();   // may be 0 if unknown
+		#if defined (__linux__)
+			cpu_set_t affinity;
+			if (sched_getaffinity (0, sizeof (affinity), & affinity) == 0)
+				number = CPU_COUNT (& affinity);
+		#endif
+		const integer cgroupLimit = getCgroupLimitOnNumberOfProcessors ();
+		if (cgroupLimit > 0 && cgroupLimit < number)
+			number = cgroupLimit;
+		return std::max (integer (1), number);
+	} ();
+	return numberOfProcessors;
+}
+
+/*
+	The blocks of a job are initially divided into one contiguous range per thread.
+	Each thread takes blocks from the front of its own range; a thread that runs out of work
+	steals the back half of the largest remaining range of another thread.
+*/
+struct MelderThread_Job {
+	const MelderThread_Body *body;
+	integer numberOfItems, blockSize, numberOfThreads;
+
+	struct Range {
+		std::mutex mutex;   // for changing the range; other threads can peek at its size without locking
+		std::atomic <integer> firstBlock, lastBlock;
+		integer size () const { return lastBlock - firstBlock + 1; }
+	};
+	std::vector <Range> ranges;   // one per thread, base 0
+
+	std::atomic <integer> nextThreadNumber { 2 };   // thread 1 is the calling thread
+	std::atomic <bool> cancelled { false };
+	integer numberOfActiveWorkers = 0;   // guarded by the mutex of the pool
+
+	std::mutex errorMutex;
+	std::exception_ptr error;
+	std::u32string errorMessage;
+
+	MelderThread_Job (const MelderThread_Body *body_, integer numberOfItems_, integer blockSize_, integer numberOfThreads_)
+		: body (body_), numberOfItems (numberOfItems_), blockSize (blockSize_), numberOfThreads (numberOfThreads_),
+		  ranges ((size_t) numberOfThreads_)
+	{
+		const integer numberOfBlocks = (numberOfItems - 1) / blockSize + 1;
+		for (integer ithread = 0; ithread < numberOfThreads; ithread ++) {
+			ranges [(size_t) ithread]. firstBlock = 1 + ithread * numberOfBlocks / numberOfThreads;
+			ranges [(size_t) ithread]. lastBlock = (ithread + 1) * numberOfBlocks / numberOfThreads;
+		}
+	}
+
+	bool hasWorkLeft () {
+		if (cancelled)
+			return false;
+		for (Range& range : ranges)
+			if (range.size () > 0)   // an unlocked peek suffices here
+				return true;
+		return false;
+	}
+
+	integer takeOwnBlock (integer ithread) {
+		Range& own = ranges [(size_t) ithread - 1];
+		std::lock_guard <std::mutex> lock (own.mutex);
+		return own.size () > 0 ? own.firstBlock ++ : 0;
+	}
+
+	integer stealBlock (integer ithread) {
+		for (;;) {
+			integer victim = 0, largestSize = 0;
+			for (integer jthread = 1; jthread <= numberOfThreads; jthread ++) {
+				const integer size = ranges [(size_t) jthread - 1]. size ();   // unlocked peek; checked again below
+				if (jthread != ithread && size > largestSize) {
+					victim = jthread;
+					largestSize = size;
+				}
+			}
+			if (victim == 0)
+				return 0;
+			integer firstStolenBlock, lastStolenBlock;
+			{
+				Range& range = ranges [(size_t) victim - 1];
+				std::lock_guard <std::mutex> lock (range.mutex);
+				if (range.size () <= 0)
+					continue;   // somebody else was faster
+				const integer numberOfStolenBlocks = (range.size () + 1) / 2;
+				lastStolenBlock = range.lastBlock;
+				firstStolenBlock = lastStolenBlock - numberOfStolenBlocks + 1;
+				range.lastBlock = firstStolenBlock - 1;
+			}
+			if (firstStolenBlock < lastStolenBlock) {
+				Range& own = ranges [(size_t) ithread - 1];
+				std::lock_guard <std::mutex> lock (own.mutex);
+				own.firstBlock = firstStolenBlock + 1;
+				own.lastBlock = lastStolenBlock;
+			}
+			return firstStolenBlock;
+		}
+	}
+
+	void run (integer ithread) noexcept {
+		try {
+			while (! cancelled) {
+				integer iblock = takeOwnBlock (ithread);
+				if (iblock == 0 && (iblock = stealBlock (ithread)) == 0)
+					break;
+				const integer firstItem = (iblock - 1) * blockSize + 1;
+				const integer lastItem = std::min (iblock * blockSize, numberOfItems);
+				(*body) (firstItem, lastItem, ithread);
+			}
+		} catch (...) {
+			std::lock_guard <std::mutex> lock (errorMutex);
+			if (! error) {
+				error = std::current_exception ();
+				errorMessage = Melder_getError ();   // the error buffer is thread-local
+			}
+			Melder_clearError ();
+			cancelled = true;
+		}
+	}
+};
+
+namespace {
+
+thread_local bool theCurrentThreadIsInAJob = false;   // a worker, or the calling thread while it takes part in a job
+thread_local integer theMaximumNumberOfThreads = 0;   // of the current thread; 0 = no limit
+
+class MelderThread_Pool {
+public:
+	integer numberOfWorkers () {
+		std::lock_guard <std::mutex> lock (d_mutex);
+		startIfNeeded ();
+		return (integer) d_workers.size ();
+	}
+
+	void setNumberOfWorkers (integer numberOfWorkers) {
+		std::lock_guard <std::mutex> resizeLock (d_resizeMutex);
+		std::vector <std::thread> oldWorkers;
+		{
+			std::lock_guard <std::mutex> lock (d_mutex);
+			Melder_require (d_jobs.empty (),
+				U"The number of worker threads cannot be changed while an analysis is running.");
+			d_started = true;   // so that startIfNeeded () leaves d_workers alone from now on
+			d_stopping = true;
+			oldWorkers.swap (d_workers);
+		}
+		d_workAvailable.notify_all ();
+		for (std::thread& worker : oldWorkers)
+			worker.join ();   // outside the lock, because the workers need it to see that they should stop
+		std::lock_guard <std::mutex> lock (d_mutex);
+		d_stopping = false;
+		for (integer iworker = 1; iworker <= numberOfWorkers; iworker ++)
+			d_workers.emplace_back (& MelderThread_Pool::work, this);
+	}
+
+	void execute (MelderThread_Job& job) {
+		{
+			std::lock_guard <std::mutex> lock (d_mutex);
+			d_jobs.push_back (& job);
+		}
+		d_workAvailable.notify_all ();
+		theCurrentThreadIsInAJob = true;   // so that nested calls from within its body run serially, as in the workers
+		job.run (1);   // the calling thread always takes part, so the job finishes even if all workers are busy
+		theCurrentThreadIsInAJob = false;
+		std::unique_lock <std::mutex> lock (d_mutex);
+		d_jobs.remove (& job);
+		d_jobFinished.wait (lock, [&] { return job.numberOfActiveWorkers == 0; });
+	}
+
+private:
+	void startIfNeeded () {   // with d_mutex locked
+		if (d_started)
+			return;
+		d_started = true;
+		const integer numberOfWorkers = MelderThread_getNumberOfProcessors () - 1;
+		for (integer iworker = 1; iworker <= numberOfWorkers; iworker ++)
+			d_workers.emplace_back (& MelderThread_Pool::work, this);
+	}
+
+	MelderThread_Job *findJob () {   // with d_mutex locked
+		for (MelderThread_Job *job : d_jobs)
+			if (job -> nextThreadNumber <= job -> numberOfThreads && job -> hasWorkLeft ())
+				return job;
+		return nullptr;
+	}
+
+	void work () {
+		theCurrentThreadIsInAJob = true;
+		for (;;) {
+			MelderThread_Job *job = nullptr;
+			{
+				std::unique_lock <std::mutex> lock (d_mutex);
+				d_workAvailable.wait (lock, [&] { return d_stopping || (job = findJob ()); });
+				if (d_stopping)
+					return;
+				job -> numberOfActiveWorkers ++;
+			}
+			const integer ithread = job -> nextThreadNumber ++;
+			if (ithread <= job -> numberOfThreads)
+				job -> run (ithread);
+			{
+				std::lock_guard <std::mutex> lock (d_mutex);
+				job -> numberOfActiveWorkers --;
+			}
+			d_jobFinished.notify_all ();
+		}
+	}
+
+	std::mutex d_mutex, d_resizeMutex;
+	std::condition_variable d_workAvailable, d_jobFinished;
+	std::vector <std::thread> d_workers;
+	std::list <MelderThread_Job *> d_jobs;
+	bool d_started = false, d_stopping = false;
+};
+
+MelderThread_Pool& thePool () {
+	static MelderThread_Pool *pool = new MelderThread_Pool;   // never destroyed: the workers should not be joined while the process exits
+	return *pool;
+}
+
+} // namespace
+
+integer MelderThread_getNumberOfWorkers () {
+	return thePool (). numberOfWorkers ();
+}
+
+void MelderThread_setNumberOfWorkers (integer numberOfWorkers) {
+	Melder_require (numberOfWorkers >= 0,
+		U"The number of worker threads should not be negative.");
+	thePool (). setNumberOfWorkers (numberOfWorkers);
+}
+
+integer MelderThread_getMaximumNumberOfThreads () {
+	return theMaximumNumberOfThreads;
+}
+
+void MelderThread_setMaximumNumberOfThreads (integer maximumNumberOfThreads) {
+	Melder_require (maximumNumberOfThreads >= 0,
+		U"The maximum number of threads should not be negative.");
+	theMaximumNumberOfThreads = maximumNumberOfThreads;
+}
+
+integer MelderThread_getNumberOfThreads (integer numberOfItems, integer blockSize) {
+	if (numberOfItems <= 0 || theCurrentThreadIsInAJob)
+		return 1;
+	const integer numberOfBlocks = (numberOfItems - 1) / blockSize + 1;
+	integer numberOfThreads = std::min (numberOfBlocks, MelderThread_getNumberOfWorkers () + 1);
+	if (theMaximumNumberOfThreads > 0)
+		numberOfThreads = std::min (numberOfThreads, theMaximumNumberOfThreads);
+	return std::max (integer (1), numberOfThreads);
+}
+
+void MelderThread_parallelFor (integer numberOfItems, integer blockSize, integer numberOfThreads, const MelderThread_Body& body) {
+	Melder_assert (blockSize >= 1);
+	if (numberOfItems <= 0)
+		return;
+	if (numberOfThreads <= 1 || theCurrentThreadIsInAJob) {
+		body (1, numberOfItems, 1);
+		return;
+	}
+	MelderThread_Job job (& body, numberOfItems, blockSize, numberOfThreads);
+	thePool (). execute (job);
+	if (job.error) {
+		Melder_appendError_noLine (job.errorMessage.c_str ());
+		std::rethrow_exception (job.error);
+	}
+}
+
+/* End of file MelderThread.cpp */
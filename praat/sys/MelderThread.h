@@ -18,6 +18,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <functional>
 #include <vector>
 #include "Thing.h"
 
@@ -79,17 +80,36 @@
 	#define MelderThread_UNLOCK(_mutex)  _mutex = 0
 #endif
 
-inline static int MelderThread_getNumberOfProcessors () {
-	#if USE_WINTHREADS
-		return 8;
-	#elif USE_PTHREADS
-		return 8;
-	#elif USE_CPPTHREADS
-		return std::thread::hardware_concurrency ();
-	#else
-		return 1;
-	#endif
-}
+integer MelderThread_getNumberOfProcessors ();
+/*
+	The number of processors that this process can actually use:
+	those in its CPU affinity mask, limited by a CPU quota of its cgroup (e.g., in a container), if any.
+	Determined once, at first use.
+*/
+
+/*
+	A pool of worker threads, shared by all analyses, that is started at first use.
+	MelderThread_parallelFor divides items 1..numberOfItems into blocks of blockSize items,
+	and calls body (firstItem, lastItem, threadNumber) for every block;
+	threads that run out of blocks steal from threads that still have some left.
+	The calling thread takes part as thread 1, so that's where progress should be reported.
+	A MelderError thrown in any of the threads cancels the remaining blocks
+	and is rethrown (with its message) in the calling thread.
+	Nested calls from within a body run serially in the current thread.
+*/
+using MelderThread_Body = std::function <void (integer firstItem, integer lastItem, integer threadNumber)>;
+integer MelderThread_getNumberOfWorkers ();
+void MelderThread_setNumberOfWorkers (integer numberOfWorkers);
+	/*
+		By default, there is one worker less than the number of processors.
+		Throws if a MelderThread_parallelFor is running (in any thread).
+	*/
+integer MelderThread_getMaximumNumberOfThreads ();
+void MelderThread_setMaximumNumberOfThreads (integer maximumNumberOfThreads);
+	/* A further limit for the analyses started from the current thread only; 0 (the default) means no limit. */
+integer MelderThread_getNumberOfThreads (integer numberOfItems, integer blockSize);
+	/* Returns the number of threads that MelderThread_parallelFor would use; at least 1. */
+void MelderThread_parallelFor (integer numberOfItems, integer blockSize, integer numberOfThreads, const MelderThread_Body& body);
 
 #if USE_WINTHREADS
 	template <class T> void MelderThread_run (DWORD (WINAPI *func) (T *), autoSomeThing <T> *args, int numberOfThreads) {
@@ -20,7 +20,7 @@
 #include <time.h>
 #include "Thing.h"
 
-integer theTotalNumberOfThings;
+std::atomic <integer> theTotalNumberOfThings { 0 };
 
 void structThing :: v_info ()
 {
@@ -198,8 +198,8 @@ void Thing_info (Thing me) {
 conststring32 Thing_getName (Thing me) { return my name.get(); }
 
 conststring32 Thing_messageName (Thing me) {
-	static MelderString buffers [19] { };
-	static int ibuffer = 0;
+	static thread_local MelderString buffers [19] { };   // Parselmouth: per thread, as used in concurrent error messages
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 19) ibuffer = 0;
 	if (my name) {
 		MelderString_copy (& buffers [ibuffer], my classInfo -> className, U" \"", my name.get(), U"\"");
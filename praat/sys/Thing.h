@@ -25,6 +25,8 @@
 	/* The macros for struct and class definitions: */
 		#include "oo.h"
 
+#include <atomic>
+
 #define _Thing_auto_DEBUG  0
 
 typedef struct structClassInfo *ClassInfo;
@@ -218,8 +220,9 @@ void _Thing_forget_nozero (Thing me);
 
 /* For debugging. */
 
-extern integer theTotalNumberOfThings;
-/* This number is 0 initially, increments at every successful `new', and decrements at every `forget'. */
+extern std::atomic <integer> theTotalNumberOfThings;
+/* This number is 0 initially, increments at every successful `new', and decrements at every `forget'.
+	Atomic, because Things can be created and forgotten on several threads at the same time. */
 
 template <class T>
 class autoSomeThing {
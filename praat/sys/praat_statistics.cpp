@@ -20,6 +20,7 @@
 #include <locale.h>
 #include <thread>
 #include "praatP.h"
+#include "../dwsys/NUM2.h"
 
 static struct {
 	integer batchSessions, interactiveSessions;
@@ -154,7 +155,7 @@ void praat_reportMemoryUse () {
 	MelderInfo_writeLine (U"Currently in use:\n"
 		U"   Strings: ", MelderString_allocationCount () - MelderString_deallocationCount ());
 	MelderInfo_writeLine (U"   Arrays: ", NUM_getTotalNumberOfArrays ());
-	MelderInfo_writeLine (U"   Things: ", theTotalNumberOfThings,
+	MelderInfo_writeLine (U"   Things: ", theTotalNumberOfThings.load (),
 		U" (objects in list: ", theCurrentPraatObjects -> n, U")");
 	integer numberOfMotifWidgets =
 	#if motif
@@ -168,6 +169,10 @@ void praat_reportMemoryUse () {
 		- theTotalNumberOfThings - NUM_getTotalNumberOfArrays ()
 		- (MelderString_allocationCount () - MelderString_deallocationCount ())
 		- numberOfMotifWidgets);
+	integer numberOfFftPlanHits, numberOfFftPlanMisses, numberOfFftPlans, numberOfFftPlanBytes;
+	NUMfft_getPlanCacheStatistics (& numberOfFftPlanHits, & numberOfFftPlanMisses, & numberOfFftPlans, & numberOfFftPlanBytes);
+	MelderInfo_writeLine (U"   FFT plans: ", numberOfFftPlans, U" (", Melder_bigInteger (numberOfFftPlanBytes), U" bytes; ",
+		numberOfFftPlanHits, U" hits, ", numberOfFftPlanMisses, U" misses)");
 	MelderInfo_writeLine (
 		U"\nMemory history of this session:\n"
 		U"   Total created: ", Melder_bigInteger (Melder_allocationCount ()), U" (", Melder_bigInteger (Melder_allocationSize ()), U" bytes)");
@@ -20,9 +20,16 @@
 #include "parselmouth/Parselmouth.h"
 #include "version.h"
 
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/sys/MelderThread.h>
 #include <praat/sys/praat.h>
 #include <praat/sys/praat_version.h>
 
+#include <pybind11/stl.h>
+
+#include <limits>
+
 #define XSTR(s) STR(s)
 #define STR(s) #s
 
@@ -37,6 +44,7 @@ Thing_declare(Function);
 Thing_declare(Harmonicity);
 Thing_declare(Harmonicity);
 Thing_declare(Intensity);
+Thing_declare(LongSound);
 Thing_declare(Matrix);
 Thing_declare(MFCC);
 Thing_declare(Pitch);
@@ -56,10 +64,23 @@ struct TimeFunction;
 struct TimeFrameSampled;
 
 class PraatModule;
+class BatchModule;
 using PraatError = MelderError;
 class PraatWarning {};
 class PraatFatal {};
 
+class ThreadLimit {
+public:
+	explicit ThreadLimit(integer numberOfThreads) : m_numberOfThreads(numberOfThreads), m_previous(0) {}
+
+	void enter() { m_previous = MelderThread_getMaximumNumberOfThreads(); MelderThread_setMaximumNumberOfThreads(m_numberOfThreads); }
+	void exit() { MelderThread_setMaximumNumberOfThreads(m_previous); }
+
+private:
+	integer m_numberOfThreads;
+	integer m_previous;
+};
+
 PRAAT_EXCEPTION_BINDING(PraatError, PyExc_RuntimeError) {
 	// Exception translators need to be convertible to void (*) (std::exception_ptr), so we cannot capture and store *this in the lambda.
 	static auto exception = *this;
@@ -71,7 +92,8 @@ PRAAT_EXCEPTION_BINDING(PraatError, PyExc_RuntimeError) {
 				// Python 2: Seems exception strings should be encoded in UTF-8
 				// Python 3: PyErr_SetString (in py::exception<type>::operator()) decodes from UTF-8
 				std::string message(Melder_peek32to8(Melder_getError()));
-				message.erase(message.length() - 1); // Remove closing newline
+				if (!message.empty() && message.back() == '\n')
+					message.pop_back(); // Remove closing newline
 				Melder_clearError();
 				exception(message.c_str());
 			}
@@ -81,6 +103,7 @@ PRAAT_EXCEPTION_BINDING(PraatError, PyExc_RuntimeError) {
 PRAAT_EXCEPTION_BINDING(PraatWarning, PyExc_UserWarning) {
 	static auto warning = *this;
 	Melder_setWarningProc([](const char32 *message) {
+			py::gil_scoped_acquire gil; // Analyses can run (and warn) with the GIL released
 			if (PyErr_WarnEx(warning.ptr(), Melder_peek32to8(message), 1) < 0)
 				throw py::error_already_set();
 	});
@@ -89,6 +112,7 @@ PRAAT_EXCEPTION_BINDING(PraatWarning, PyExc_UserWarning) {
 PRAAT_EXCEPTION_BINDING(PraatFatal, PyExc_BaseException) {
 	static auto fatal = *this;
 	Melder_setFatalProc([](const char32 *message) {
+			py::gil_scoped_acquire gil;
 			auto extraMessage = "Parselmouth intercepted a fatal error in Praat:\n\n"s +
 			                    Melder_peek32to8(message) + "\n"s +
 			                    "To ensure correctness of Praat's calculations, it is advisable to NOT ignore this error\n"s
@@ -98,8 +122,30 @@ PRAAT_EXCEPTION_BINDING(PraatFatal, PyExc_BaseException) {
 	});
 }
 
+CLASS_BINDING(ThreadLimit, ThreadLimit)
+BINDING_CONSTRUCTOR(ThreadLimit, "limit_num_threads", R"(Limit the number of threads used by analyses within a ``with`` block.
+
+The limit only applies to analyses started from the current Python
+thread, and comes on top of the global number of threads set by
+`set_num_threads`. For example::
+
+    with parselmouth.limit_num_threads(1):
+        pitch = sound.to_pitch()
+)")
+BINDING_INIT(ThreadLimit) {
+	def(py::init<Positive<integer>>(),
+	    "number_of_threads"_a);
+
+	def("__enter__",
+	    [](ThreadLimit &self) { self.enter(); });
+
+	def("__exit__",
+	    [](ThreadLimit &self, py::args) { self.exit(); });
+}
+
 void redirectMelderInfo() {
 	Melder_setInformationProc([](const char32 *message, size_t i) {
+		py::gil_scoped_acquire gil;
 		auto sys = py::module::import("sys");
 		auto sys_stdout = sys.attr("stdout");
 		sys_stdout.attr("write")(&message[i]);
@@ -109,6 +155,7 @@ void redirectMelderInfo() {
 
 void redirectMelderError() {
 	Melder_setErrorProc([](const char32 *message) {
+		py::gil_scoped_acquire gil;
 		auto sys = py::module::import("sys");
 		auto sys_stderr = sys.attr("stderr");
 		sys_stderr.attr("write")(message);
@@ -120,6 +167,7 @@ void redirectMelderError() {
 using PraatBindings = Bindings<PraatError,
                                PraatWarning,
                                PraatFatal,
+                               ThreadLimit,
                                Interpolation,
                                WindowShape,
                                AmplitudeScaling,
@@ -138,6 +186,7 @@ using PraatBindings = Bindings<PraatError,
                                Matrix,
                                Vector,
                                Sound,
+                               LongSound,
                                Spectrum,
                                Spectrogram,
                                Pitch,
@@ -147,7 +196,8 @@ using PraatBindings = Bindings<PraatError,
                                CC,
                                MFCC,
                                TextGrid,
-                               PraatModule>;
+                               PraatModule,
+                               BatchModule>;
 
 } // namespace parselmouth
 
@@ -203,4 +253,18 @@ PYBIND11_MODULE(parselmouth, m) {
 	bindings.init();
 
 	m.attr("read") = bindings.get<Data>().get().attr("read");
+
+	m.def("get_num_threads",
+	      []() { return MelderThread_getNumberOfThreads(std::numeric_limits<integer>::max(), 1); },
+	      "Get the number of threads that an analysis started from the current\n"
+	      "Python thread can use, including the calling thread itself.");
+
+	m.def("set_num_threads",
+	      [](std::optional<parselmouth::Positive<integer>> numberOfThreads) { MelderThread_setNumberOfWorkers((numberOfThreads ? static_cast<integer>(*numberOfThreads) : MelderThread_getNumberOfProcessors()) - 1); },
+	      "number_of_threads"_a = std::nullopt,
+	      py::call_guard<py::gil_scoped_release>(),
+	      "Set the total number of threads used by Praat's parallel analyses.\n\n"
+	      "By default (or when passing ``None``), this is the number of\n"
+	      "processors available to this process, taking into account its CPU\n"
+	      "affinity and the CPU quota of its container.");
 }
@@ -26,6 +26,8 @@
 
 #include <praat/fon/Formant.h>
 
+#include <pybind11/numpy.h>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -38,9 +40,29 @@ PRAAT_ENUM_BINDING(FormantUnit) {
 	make_implicitly_convertible_from_string(*this);
 }
 
+PRAAT_STRUCT_BINDING(Frame, Formant_Frame, py::buffer_protocol()) {
+	using FormantFormant = structFormant_Formant;
+	PYBIND11_NUMPY_DTYPE(FormantFormant, frequency, bandwidth);
+
+	// An empty frame (e.g. in silence) has no formants allocated, so never take the address of formant[1] then
+	def_buffer([](structFormant_Frame &self) {
+		static structFormant_Formant noFormants[1];
+		return py::buffer_info(self.nFormants > 0 ? &self.formant[1] : noFormants, sizeof(structFormant_Formant), py::format_descriptor<structFormant_Formant>::format(), self.nFormants);
+	});
+
+	def_readonly("intensity", &structFormant_Frame::intensity);
+
+	def("__len__",
+	    [](Formant_Frame self) { return self->nFormants; });
+
+	def("as_array", [](Formant_Frame self) { return self->nFormants > 0 ? py::array(self->nFormants, &self->formant[1], py::cast(self)) : py::array_t<structFormant_Formant>(0); });
+}
+
 PRAAT_CLASS_BINDING(Formant) {
 	addTimeFrameSampledMixin(*this);
 
+	NESTED_BINDINGS(Formant_Frame)
+
 	using signature_cast_placeholder::_;
 
 	def("get_value_at_time", // TODO Enum for Hertz vs. Bark?
@@ -50,6 +72,27 @@ PRAAT_CLASS_BINDING(Formant) {
 	def("get_bandwidth_at_time",
 	    args_cast<_, Positive<_>, _, _>(Formant_getBandwidthAtTime),
 	    "formant_number"_a, "time"_a, "unit"_a = kFormant_unit::HERTZ);
+
+	def_readonly("max_n_formants", &structFormant::maxnFormants);
+
+	def("get_frame",
+	    [](Formant self, Positive<integer> frameNumber) {
+		    if (frameNumber > self->nx) Melder_throw(U"Frame number out of range");
+		    return &self->d_frames[frameNumber];
+	    },
+	    "frame_number"_a, py::return_value_policy::reference_internal);
+
+	def("__getitem__",
+	    [](Formant self, long i) {
+		    if (i < 0) i += self->nx; // Python-style negative indexing
+		    if (i < 0 || i >= self->nx) throw py::index_error("Formant index out of range");
+		    return &self->d_frames[i+1];
+	    },
+	    "i"_a, py::return_value_policy::reference_internal);
+
+	def("__iter__",
+	    [](Formant self) { return py::make_iterator(&self->d_frames[1], &self->d_frames[self->nx+1]); },
+	    py::keep_alive<0, 1>());
 }
 
 } // namespace parselmouth
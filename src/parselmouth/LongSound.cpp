@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Parselmouth.h"
+#include "TimeClassAspects.h"
+
+#include "utils/praat/MelderUtils.h"
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/fon/LongSound.h>
+#include <praat/fon/LongSound_to_Intensity.h>
+#include <praat/fon/LongSound_to_Pitch.h>
+
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+PRAAT_STRUCT_BINDING(PitchSegments, LongSound_PitchStream) {
+	def("__iter__",
+	    [](py::object self) { return self; });
+
+	def("__next__",
+	    [](LongSound_PitchStream self) {
+		    auto pitch = LongSound_PitchStream_next(self);
+		    if (!pitch)
+			    throw py::stop_iteration();
+		    return pitch;
+	    });
+
+	def("next", // Python 2
+	    [](py::object self) { return self.attr("__next__")(); });
+}
+
+PRAAT_CLASS_BINDING(LongSound) {
+	addTimeFrameSampledMixin(*this);
+
+	NESTED_BINDINGS(LongSound_PitchStream)
+
+	def(py::init([](const std::u32string &filePath) {
+		    auto file = pathToMelderFile(filePath);
+		    return LongSound_open(&file);
+	    }),
+	    "file_path"_a);
+
+	// No GIL release for LongSound: all reading goes through the single file pointer and buffer of the LongSound
+
+	def_readonly("n_channels", &structLongSound::numberOfChannels);
+
+	def_readonly("sampling_frequency", &structLongSound::sampleRate);
+
+	def("extract_part",
+	    [](LongSound self, std::optional<double> fromTime, std::optional<double> toTime, bool preserveTimes) { return LongSound_extractPart(self, fromTime.value_or(self->xmin), toTime.value_or(self->xmax), preserveTimes); },
+	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "preserve_times"_a = false);
+
+	def("to_intensity",
+	    [](LongSound self, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean, bool fast) { return LongSound_to_Intensity(self, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean, fast); },
+	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, "fast"_a = false,
+	    R"(Analyse the intensity of this LongSound, one part at a time.
+
+Returns the same `Intensity` as `Sound.to_intensity` on the whole
+sound, but only reads about a minute of samples into memory at a
+time.)");
+
+	def("to_pitch_segments",
+	    [](LongSound self, Positive<double> segmentDuration, NonNegative<double> lookahead, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<double> pitchCeiling) {
+		    structLongSound_PitchStream stream;
+		    LongSound_PitchStream_init(&stream, self, segmentDuration, lookahead, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, 3.0, 15, 0 /* AC_HANNING */, 0.03, 0.45, 0.01, 0.35, 0.14, pitchCeiling); // Same defaults as Sound_to_Pitch
+		    return stream;
+	    },
+	    "segment_duration"_a = 60.0, "lookahead"_a = 2.0, "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0,
+	    py::keep_alive<0, 1>(), R"(Analyse the pitch of this LongSound, one segment at a time.
+
+Returns an iterator over consecutive `Pitch` objects, each containing
+the frames of about ``segment_duration`` seconds, and together covering
+the whole file. Only one segment (plus its context) is read from the
+file and analysed at a time, so memory use does not grow with the
+length of the file.
+
+The frames and their candidates are the same as those of `Sound.to_pitch`
+on the whole sound. The path finder, however, only looks ``lookahead``
+seconds beyond the frames of a segment, so the selected candidates may
+differ near segment boundaries when that is not enough context.)");
+}
+
+} // namespace parselmouth
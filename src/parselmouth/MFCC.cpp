@@ -51,6 +51,17 @@ PRAAT_CLASS_BINDING(MFCC) {
 	    args_cast<_, Positive<_>, _>(MFCC_to_Matrix_features),
 	    "window_length"_a = 0.025, "include_energy"_a = false);
 
+	def("to_matrix_with_deltas",
+	    args_cast<_, Positive<_>, _>(MFCC_to_Matrix_withDeltas),
+	    "number_of_frames_each_side"_a = 2, "include_delta_deltas"_a = true,
+	    R"(Get the coefficients of all frames, with their deltas and delta-deltas.
+
+Returns a `Matrix` with a column per frame and rows c0, c1, ..., cN,
+followed by the deltas of these rows and, if ``include_delta_deltas``
+is true, the deltas of the deltas. A delta is the slope of a regression
+over ``number_of_frames_each_side`` frames before and after each frame,
+repeating the first and last frames beyond the edges.)");
+
 	def("to_sound",
 	    &MFCC_to_Sound);
 
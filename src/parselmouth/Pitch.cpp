@@ -59,14 +59,20 @@ PRAAT_STRUCT_BINDING(Candidate, Pitch_Candidate) {
 	// TODO Reference to Pitch_Frame to have ".select()"?
 }
 
-PRAAT_STRUCT_BINDING(Frame, Pitch_Frame) {
+PRAAT_STRUCT_BINDING(Frame, Pitch_Frame, py::buffer_protocol()) {
 	using PitchCandidate = structPitch_Candidate;
 	PYBIND11_NUMPY_DTYPE(PitchCandidate, frequency, strength);
 
+	// An empty frame may not have allocated its candidates, so never take the address of candidate[1] then
+	def_buffer([](structPitch_Frame &self) {
+		static structPitch_Candidate noCandidates[1];
+		return py::buffer_info(self.nCandidates > 0 ? &self.candidate[1] : noCandidates, sizeof(structPitch_Candidate), py::format_descriptor<structPitch_Candidate>::format(), self.nCandidates);
+	});
+
 	def_readonly("intensity", &structPitch_Frame::intensity);
 
 	def_property("selected",
-	             [](Pitch_Frame self) { return &self->candidate[1]; },
+	             [](Pitch_Frame self) { return self->nCandidates > 0 ? &self->candidate[1] : nullptr; },
 	             [](Pitch_Frame self, Pitch_Candidate candidate) {
 		             for (long j = 1; j <= self->nCandidates; j++) {
 			             if (&self->candidate[j] == candidate) {
@@ -77,7 +83,7 @@ PRAAT_STRUCT_BINDING(Frame, Pitch_Frame) {
 		             throw py::value_error("'candidate' is not a Pitch Candidate of this frame");
 	             });
 
-	def_property_readonly("candidates", [](Pitch_Frame self) { return std::vector<structPitch_Candidate>(&self->candidate[1], &self->candidate[self->nCandidates + 1]); });
+	def_property_readonly("candidates", [](Pitch_Frame self) { return self->nCandidates > 0 ? std::vector<structPitch_Candidate>(&self->candidate[1], &self->candidate[1] + self->nCandidates) : std::vector<structPitch_Candidate>(); });
 
 	def("unvoice",
 	    [](Pitch_Frame self) {
@@ -120,7 +126,7 @@ PRAAT_STRUCT_BINDING(Frame, Pitch_Frame) {
 	def("__len__",
 	    [](Pitch_Frame self) { return self->nCandidates; });
 
-	def("as_array", [](Pitch_Frame self) { return py::array(self->nCandidates, &self->candidate[1], py::cast(self)); });
+	def("as_array", [](Pitch_Frame self) { return self->nCandidates > 0 ? py::array(self->nCandidates, &self->candidate[1], py::cast(self)) : py::array_t<structPitch_Candidate>(0); });
 
 	// TODO __setitem__ ?
 	// TODO Make number of candidates changeable?
@@ -138,15 +144,18 @@ PRAAT_CLASS_BINDING(Pitch) {
 
 	def("to_sound_pulses",
 		[](Pitch self, std::optional<double> fromTime, std::optional<double> toTime) { return Pitch_to_Sound(self, fromTime.value_or(self->xmin), toTime.value_or(self->xmax), false); },
-		"from_time"_a = std::nullopt, "to_time"_a = std::nullopt);
+		"from_time"_a = std::nullopt, "to_time"_a = std::nullopt,
+		py::call_guard<py::gil_scoped_release>());
 
 	def("to_sound_hum",
 	    [](Pitch self, std::optional<double> fromTime, std::optional<double> toTime) { return Pitch_to_Sound(self, fromTime.value_or(self->xmin), toTime.value_or(self->xmax), true); },
-	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt);
+	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_sound_sine",
 	    [](Pitch self, std::optional<double> fromTime, std::optional<double> toTime, Positive<double> samplingFrequency, double roundToNearestZeroCrossing) { return Pitch_to_Sound_sine(self, fromTime.value_or(self->xmin), toTime.value_or(self->xmax), samplingFrequency, roundToNearestZeroCrossing); },
-	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "sampling_frequency"_a = 44100.0, "round_to_nearest_zero_crossing"_a = true);
+	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "sampling_frequency"_a = 44100.0, "round_to_nearest_zero_crossing"_a = true,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("count_voiced_frames",
 		&Pitch_countVoicedFrames);
@@ -225,23 +234,27 @@ PRAAT_CLASS_BINDING(Pitch) {
 	// TODO To PointProcess: depends on PointProcess
 
 	def("interpolate",
-	    &Pitch_interpolate);
+	    &Pitch_interpolate,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("smooth",
 		args_cast<_, Positive<_>>(Pitch_smooth),
-		"bandwidth"_a = 10.0);
+		"bandwidth"_a = 10.0,
+		py::call_guard<py::gil_scoped_release>());
 
 	def("subtract_linear_fit",
 	    &Pitch_subtractLinearFit,
 		"unit"_a = kPitch_unit::HERTZ);
 
 	def("kill_octave_jumps",
-		&Pitch_killOctaveJumps);
+		&Pitch_killOctaveJumps,
+		py::call_guard<py::gil_scoped_release>());
 
 	// TODO To PitchTier: depends on PitchTier
 
 	def("to_matrix",
-	    &Pitch_to_Matrix);
+	    &Pitch_to_Matrix,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def_readwrite("ceiling", &structPitch::ceiling);
 
@@ -318,7 +331,8 @@ PRAAT_CLASS_BINDING(Pitch) {
 
 	def("path_finder",
 	    args_cast<_, _, _, _, _, _, Positive<_>, bool>(Pitch_pathFinder),
-	    "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "ceiling"_a = 600.0, "pull_formants"_a = false);
+	    "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "ceiling"_a = 600.0, "pull_formants"_a = false,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("step",
 	    [](Pitch self, double step, Positive<double> precision, std::optional<double> fromTime, std::optional<double> toTime) { Pitch_step(self, step, precision, fromTime.value_or(self->xmin), toTime.value_or(self->xmax)); },
@@ -25,6 +25,8 @@
 #include "utils/pybind11/ImplicitStringToEnumConversion.h"
 #include "utils/pybind11/NumericPredicates.h"
 
+#include <praat/LPC/Cepstrogram.h>
+#include <praat/dwsys/NUM2.h>
 #include <praat/dwtools/Sound_extensions.h>
 #include <praat/dwtools/Sound_to_MFCC.h>
 #include <praat/dwtools/Sound_to_Pitch2.h>
@@ -39,6 +41,9 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <cstring>
+#include <type_traits>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -54,6 +59,73 @@ OrderedOf<T> referencesToOrderedOf(const Container &container) // TODO type_cast
 	return orderedOf;
 }
 
+template <typename T>
+void copyIntoSound(Sound sound, const py::array &values)
+{
+	// Converts straight from the array's own buffer and layout, instead of first making a C-contiguous float64 copy
+	// The samples themselves stay double: every Matrix descendant shares the double **z that all of Praat indexes directly
+	auto ndim = values.ndim();
+	auto data = static_cast<const char *>(values.data());
+	auto channelStride = ndim == 2 ? values.strides(0) : 0;
+	auto sampleStride = values.strides(ndim-1);
+
+	auto element = [](const char *p) { T x; std::memcpy(&x, p, sizeof(T)); return static_cast<double>(x); };
+
+	if (std::is_same<T, double>::value && sampleStride == sizeof(double)) {
+		for (integer i = 1; i <= sound->ny; ++i)
+			std::memcpy(&sound->z[i][1], data + (i-1) * channelStride, sound->nx * sizeof(double));
+	}
+	else if (std::abs(channelStride) < std::abs(sampleStride)) { // E.g. Fortran-ordered or interleaved: walk through memory in order
+		for (integer j = 1; j <= sound->nx; ++j)
+			for (integer i = 1; i <= sound->ny; ++i)
+				sound->z[i][j] = element(data + (i-1) * channelStride + (j-1) * sampleStride);
+	}
+	else {
+		for (integer i = 1; i <= sound->ny; ++i)
+			for (integer j = 1; j <= sound->nx; ++j)
+				sound->z[i][j] = element(data + (i-1) * channelStride + (j-1) * sampleStride);
+	}
+}
+
+template <typename T>
+bool hasDtype(const py::array &values)
+{
+	return py::isinstance<py::array_t<T>>(values); // Checks for an equivalent dtype (including byte order) only
+}
+
+autoSound soundFromArray(py::array values, Positive<double> samplingFrequency, double startTime)
+{
+	// Only one overload for all supported dtypes, since pybind11 first tries every overload without converting any argument:
+	// e.g. an int sampling frequency would otherwise skip the float32 overload and make the float64 one convert the whole array
+	auto copy = hasDtype<double>(values) ? &copyIntoSound<double> :
+	            hasDtype<float>(values) ? &copyIntoSound<float> :
+	            hasDtype<int16_t>(values) ? &copyIntoSound<int16_t> :
+	            hasDtype<int32_t>(values) ? &copyIntoSound<int32_t> :
+	            nullptr;
+	if (!copy) {
+		values = py::array_t<double, py::array::forcecast>(values);
+		copy = &copyIntoSound<double>;
+	}
+
+	auto ndim = values.ndim();
+
+	if (ndim == 0)
+		throw py::value_error("Cannot create Sound from a single 0-dimensional number");
+	if (ndim > 2)
+		throw py::value_error("Cannot create Sound from an array with more than 2 dimensions");
+
+	auto nx = values.shape(ndim-1);
+	auto ny = ndim == 2 ? values.shape(0) : 1;
+	auto result = Sound_create(ny, startTime, startTime + nx / samplingFrequency, nx, 1.0 / samplingFrequency, startTime + 0.5 / samplingFrequency);
+
+	{
+		py::gil_scoped_release release;
+		copy(result.get(), values);
+	}
+
+	return result;
+}
+
 } // namespace
 
 enum class SoundFileFormat // TODO Nest within Sound?
@@ -93,6 +165,21 @@ enum class ToHarmonicityMethod
 	GNE
 };
 
+enum class ResampleMethod
+{
+	SINC,
+	POLYPHASE_FAST,
+	POLYPHASE_MEDIUM,
+	POLYPHASE_BEST
+};
+
+enum class SpectrumPadding
+{
+	NONE,
+	POWER_OF_TWO,
+	FAST_SIZE
+};
+
 
 // TODO Export befóre using default values for them
 // TODO Can be nested within Sound? Valid documentation (i.e. parselmouth.Sound.WindowShape instead of parselmouth.WindowShape)?
@@ -181,40 +268,38 @@ PRAAT_ENUM_BINDING(ToHarmonicityMethod) {
 	make_implicitly_convertible_from_string(*this);
 }
 
+PRAAT_ENUM_BINDING(ResampleMethod) {
+	value("SINC", ResampleMethod::SINC);
+	value("POLYPHASE_FAST", ResampleMethod::POLYPHASE_FAST);
+	value("POLYPHASE_MEDIUM", ResampleMethod::POLYPHASE_MEDIUM);
+	value("POLYPHASE_BEST", ResampleMethod::POLYPHASE_BEST);
+
+	make_implicitly_convertible_from_string(*this);
+}
+
+PRAAT_ENUM_BINDING(SpectrumPadding) {
+	value("NONE", SpectrumPadding::NONE);
+	value("POWER_OF_TWO", SpectrumPadding::POWER_OF_TWO);
+	value("FAST_SIZE", SpectrumPadding::FAST_SIZE);
+
+	make_implicitly_convertible_from_string(*this);
+}
+
 PRAAT_CLASS_BINDING(Sound) {
 	addTimeFrameSampledMixin(*this);
 
 	NESTED_BINDINGS(ToPitchMethod,
-	                ToHarmonicityMethod)
+	                ToHarmonicityMethod,
+	                ResampleMethod,
+	                SpectrumPadding)
 
 	using signature_cast_placeholder::_;
 
-	def(py::init([](py::array_t<double, 0> values, Positive<double> samplingFrequency, double startTime) { // TODO py::array::c_style to be able to memcpy / NUMmatrix_copyElements ?
-		    auto ndim = values.ndim();
-
-		    if (ndim == 0)
-			    throw py::value_error("Cannot create Sound from a single 0-dimensional number");
-		    if (ndim > 2)
-			    throw py::value_error("Cannot create Sound from an array with more than 2 dimensions");
-
-		    auto nx = values.shape(ndim-1);
-		    auto ny = ndim == 2 ? values.shape(0) : 1;
-		    auto result = Sound_create(ny, startTime, startTime + nx / samplingFrequency, nx, 1.0 / samplingFrequency, startTime + 0.5 / samplingFrequency);
-
-		    if (ndim == 2) {
-			    auto unchecked = values.unchecked<2>();
-			    for (ssize_t i = 0; i < ny; ++i)
-				    for (ssize_t j = 0; j < nx; ++j)
-					    result->z[i+1][j+1] = unchecked(i, j);
-		    }
-		    else {
-			    auto unchecked = values.unchecked<1>();
-			    for (ssize_t j = 0; j < nx; ++j)
-				    result->z[1][j+1] = unchecked(j);
-		    }
+	def(py::init(&soundFromArray),
+	    "values"_a, "sampling_frequency"_a = 44100.0, "start_time"_a = 0.0);
 
-		    return result;
-	    }),
+	// Other array-likes (e.g., lists) are converted to float64 by NumPy
+	def(py::init([](py::array_t<double, py::array::forcecast> values, Positive<double> samplingFrequency, double startTime) { return soundFromArray(values, samplingFrequency, startTime); }),
 	    "values"_a, "sampling_frequency"_a = 44100.0, "start_time"_a = 0.0);
 
 	def(py::init([](const std::u32string &filePath) {
@@ -467,8 +552,34 @@ PRAAT_CLASS_BINDING(Sound) {
 	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "overlap"_a);
 
 	def("resample",
-	    &Sound_resample,
-	    "new_frequency"_a, "precision"_a = 50);
+	    [](Sound self, Positive<double> newFrequency, integer precision, ResampleMethod method) {
+		    switch (method) { // Number of zero crossings, transition width, and phases per zero crossing, for about 40, 75, and 115 dB of alias attenuation
+		    case ResampleMethod::SINC:
+			    return Sound_resample(self, newFrequency, precision);
+		    case ResampleMethod::POLYPHASE_FAST:
+			    return Sound_resample_polyphase(self, newFrequency, 8, 0.3, 64);
+		    case ResampleMethod::POLYPHASE_MEDIUM:
+			    return Sound_resample_polyphase(self, newFrequency, 32, 0.15, 256);
+		    case ResampleMethod::POLYPHASE_BEST:
+			    return Sound_resample_polyphase(self, newFrequency, 96, 0.08, 1024);
+		    }
+		    return autoSound(); // Unreachable
+	    },
+	    "new_frequency"_a, "precision"_a = 50, "method"_a = ResampleMethod::SINC,
+	    py::call_guard<py::gil_scoped_release>(), R"(Resample this Sound to a new sampling frequency.
+
+With the default ``SINC`` method, the Sound is first low-pass filtered
+in the frequency domain (when downsampling), and then interpolated
+with a sin(x)/x interpolation of depth ``precision``.
+
+The ``POLYPHASE_FAST``, ``POLYPHASE_MEDIUM``, and ``POLYPHASE_BEST``
+methods instead convolve the Sound with a single windowed-sinc
+low-pass filter of increasing length, which is faster and does not
+need memory proportional to the length of the Sound. Aliases are
+attenuated by about 40, 75, and 115 dB, and the pass band ends 30%,
+15%, and 8% below the lower of the two Nyquist frequencies. The length
+of these filters is fixed by the method, so ``precision`` has no
+effect on them.)");
 
 	def("lengthen", // TODO Lengthen (Overlap-add) ?
 	    [](Sound self, Positive<double> minimumPitch, Positive<double> maximumPitch, Positive<double> factor) {
@@ -476,16 +587,19 @@ PRAAT_CLASS_BINDING(Sound) {
 			    Melder_throw (U"Maximum pitch should be greater than minimum pitch.");
 		    return Sound_lengthen_overlapAdd(self, minimumPitch, maximumPitch, factor);
 	    },
-	    "minimum_pitch"_a = 75.0, "maximum_pitch"_a = 600.0, "factor"_a);
+	    "minimum_pitch"_a = 75.0, "maximum_pitch"_a = 600.0, "factor"_a,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("deepen_band_modulation",
 	    args_cast<_, Positive<_>, Positive<_>, Positive<_>, Positive<_>, Positive<_>, Positive<_>>(Sound_deepenBandModulation),
-	    "enhancement"_a = 20.0, "from_frequency"_a = 300.0, "to_frequency"_a = 8000.0, "slow_modulation"_a = 3.0, "fast_modulation"_a = 30.0, "band_smoothing"_a = 100.0);
+	    "enhancement"_a = 20.0, "from_frequency"_a = 300.0, "to_frequency"_a = 8000.0, "slow_modulation"_a = 3.0, "fast_modulation"_a = 30.0, "band_smoothing"_a = 100.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	// TODO Args cast for std::optional and std::optional ranges!
 	def("to_pitch",
 	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<double> pitchCeiling) { return Sound_to_Pitch(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling); },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_pitch",
 	    [](Sound self, ToPitchMethod method, py::args args, py::kwargs kwargs) -> py::object {
@@ -509,28 +623,32 @@ PRAAT_CLASS_BINDING(Sound) {
 		    if (maxNumberOfCandidates <= 1) Melder_throw (U"Your maximum number of candidates should be greater than 1.");
 		    return Sound_to_Pitch_ac(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, 3.0, maxNumberOfCandidates, veryAccurate, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling);
 	    },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = true, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = true, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_pitch_cc",
-	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<int> maxNumberOfCandidates, bool veryAccurate, double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, Positive<double> pitchCeiling) {
+	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<int> maxNumberOfCandidates, bool veryAccurate, double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, Positive<double> pitchCeiling, bool fast) {
 		    if (maxNumberOfCandidates <= 1) Melder_throw (U"Your maximum number of candidates should be greater than 1.");
-		    return Sound_to_Pitch_cc(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, 1.0, maxNumberOfCandidates, veryAccurate, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling);
+		    return Sound_to_Pitch_cc(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, 1.0, maxNumberOfCandidates, veryAccurate, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling, fast);
 	    },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = true, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = true, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, "fast"_a = false,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_pitch_spinet",
 	    [](Sound self, Positive<double> timeStep, Positive<double> windowLength, Positive<double> minimumFilterFrequency, Positive<double> maximumFilterFrequency, Positive<long> numberOfFilters, Positive<double> ceiling, Positive<int> maxNumberOfCandidates) {
 		    if (minimumFilterFrequency >= maximumFilterFrequency) Melder_throw(U"Maximum frequency must be larger than minimum frequency.");
 		    return Sound_to_Pitch_SPINET(self, timeStep, windowLength, minimumFilterFrequency, maximumFilterFrequency, numberOfFilters, ceiling, maxNumberOfCandidates);
 	    },
-	    "time_step"_a = 0.005, "window_length"_a = 0.04, "minimum_filter_frequency"_a = 70.0, "maximum_filter_frequency"_a = 5000.0, "number_of_filters"_a = 250, "ceiling"_a = 500.0, "max_number_of_candidates"_a = 15);
+	    "time_step"_a = 0.005, "window_length"_a = 0.04, "minimum_filter_frequency"_a = 70.0, "maximum_filter_frequency"_a = 5000.0, "number_of_filters"_a = 250, "ceiling"_a = 500.0, "max_number_of_candidates"_a = 15,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_pitch_shs",
 	    [](Sound self, Positive<double> timeStep, Positive<double> minimumPitch, Positive<long> maxNumberOfCandidates, Positive<double> maximumFrequencyComponent, Positive<long> maxNumberOfSubharmonics, Positive<double> compressionFactor, Positive<double> ceiling, Positive<long> numberOfPointsPerOctave) {
 		    if (minimumPitch >= ceiling) Melder_throw(U"Minimum pitch should be smaller than ceiling.");
 		    if (ceiling > maximumFrequencyComponent) Melder_throw(U"Maximum frequency must be greater than or equal to ceiling.");
 		    return Sound_to_Pitch_shs(self, timeStep, minimumPitch, maximumFrequencyComponent, ceiling, maxNumberOfSubharmonics, maxNumberOfCandidates, compressionFactor, numberOfPointsPerOctave);
-	    }, "time_step"_a = 0.01, "minimum_pitch"_a = 50.0, "max_number_of_candidates"_a = 15, "maximum_frequency_component"_a = 1250.0, "max_number_of_subharmonics"_a = 15, "compression_factor"_a = 0.84, "ceiling"_a = 600.0, "number_of_points_per_octave"_a = 48);
+	    }, "time_step"_a = 0.01, "minimum_pitch"_a = 50.0, "max_number_of_candidates"_a = 15, "maximum_frequency_component"_a = 1250.0, "max_number_of_subharmonics"_a = 15, "compression_factor"_a = 0.84, "ceiling"_a = 600.0, "number_of_points_per_octave"_a = 48,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_harmonicity",
 	    [](Sound self, ToHarmonicityMethod method, py::args args, py::kwargs kwargs) -> py::object {
@@ -549,36 +667,70 @@ PRAAT_CLASS_BINDING(Sound) {
 
 	def("to_harmonicity_cc",
 	    args_cast<_, Positive<_>, Positive<_>, _, Positive<_>>(Sound_to_Harmonicity_cc),
-	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0);
+	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_harmonicity_ac",
 	    args_cast<_, Positive<_>, Positive<_>, _, Positive<_>>(Sound_to_Harmonicity_ac),
-	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0);
+	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_harmonicity_gne",
-	    args_cast<_, Positive<_>, Positive<_>, Positive<_>, Positive<_>>(Sound_to_Harmonicity_GNE),
-	    "minimum_frequency"_a = 500.0, "maximum_frequency"_a = 4500.0, "bandwidth"_a = 1000.0, "step"_a = 80.0);
+	    [](Sound self, Positive<double> minimumFrequency, Positive<double> maximumFrequency, Positive<double> bandwidth, Positive<double> step, std::optional<Positive<integer>> maxBandsInMemory) { return Sound_to_Harmonicity_GNE_boundedMemory(self, minimumFrequency, maximumFrequency, bandwidth, step, maxBandsInMemory ? static_cast<integer>(*maxBandsInMemory) : 0); },
+	    "minimum_frequency"_a = 500.0, "maximum_frequency"_a = 4500.0, "bandwidth"_a = 1000.0, "step"_a = 80.0, "max_bands_in_memory"_a = std::nullopt,
+	    py::call_guard<py::gil_scoped_release>(), R"(Compute the glottal-to-noise excitation ratio (GNE) matrix of this Sound.
+
+The Hilbert envelopes of the frequency bands and their cross-correlations
+are computed on multiple threads. By default, the envelopes of all bands
+are kept in memory at the same time, i.e. about 80 kB per second of
+sound for every band. With ``max_bands_in_memory`` (at least 2), only
+that many envelopes are kept, and the others are computed again when
+they are needed, which takes more time but gives the same matrix.)");
 
 	def("autocorrelate",
 	    &Sound_autoCorrelate,
-	    "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_spectrum",
-	    args_cast<_, bool>(Sound_to_Spectrum),
-	    "fast"_a = true);
+	    [](Sound self, bool fast, std::optional<SpectrumPadding> padding) {
+		    switch (padding.value_or(fast ? SpectrumPadding::POWER_OF_TWO : SpectrumPadding::NONE)) {
+		    case SpectrumPadding::NONE:
+			    return Sound_to_Spectrum_padded(self, self->nx);
+		    case SpectrumPadding::POWER_OF_TWO:
+			    return Sound_to_Spectrum(self, true);
+		    case SpectrumPadding::FAST_SIZE:
+			    return Sound_to_Spectrum_padded(self, NUMfft_getFastSize(self->nx));
+		    }
+		    return autoSpectrum(); // Unreachable
+	    },
+	    "fast"_a = true, "padding"_a = std::nullopt,
+	    py::call_guard<py::gil_scoped_release>(), R"(Compute the Fourier transform of this Sound.
+
+The Sound is padded with zeroes to the number of samples given by
+``padding``: to the next power of two (``POWER_OF_TWO``, the default,
+or ``fast=True``), not at all (``NONE``, or ``fast=False``), or to the
+next number without prime factors other than 2, 3, 5, and 7
+(``FAST_SIZE``), which costs little more time than a power of two but
+adds at most a few percent of samples, instead of up to twice as many.
+Any length, even a prime number of samples, is transformed in time
+proportional to N log N. If given, ``padding`` overrides ``fast``.)");
 
 	def("to_spectrogram",
 	    [](Sound self, Positive<double> windowLength, Positive<double> maximumFrequency, Positive<double> timeStep, Positive<double> frequencyStep, kSound_to_Spectrogram_windowShape windowShape) { return Sound_to_Spectrogram(self, windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0); },
-	    "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN);
+	    "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_formant_burg", // TODO Praat has Max. number of formants as REAL? What the hell? "Pi formants for me, please."? (I know, I know; see Praat documentation)
-	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom) { return Sound_to_Formant_burg(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom); },
-	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0);
+	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, std::optional<Positive<integer>> numberOfThreads) { return Sound_to_Formant_burg(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom, numberOfThreads ? static_cast<integer>(*numberOfThreads) : 0); },
+	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "number_of_threads"_a = std::nullopt,
+	    py::call_guard<py::gil_scoped_release>());
 	// TODO To Formant...
 
 	def("to_intensity",
-	    [](Sound self, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean) { return Sound_to_Intensity(self, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean); },
-	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true);
+	    [](Sound self, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean, bool fast) { return (fast ? Sound_to_Intensity_fast : Sound_to_Intensity)(self, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean); },
+	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, "fast"_a = false,
+	    py::call_guard<py::gil_scoped_release>());
 
 	// TODO Filters
 	// TODO Group different filters into enum/class/...?
@@ -601,11 +753,13 @@ PRAAT_CLASS_BINDING(Sound) {
 
 	def("convolve",
 	    &Sounds_convolve,
-	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("cross_correlate",
 	    &Sounds_crossCorrelate,
-	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO,
+	    py::call_guard<py::gil_scoped_release>());
 	// TODO Cross-correlate (short)?
 
 	def("to_mfcc", // Watch out for different order of arguments in interface than in Sound_to_MFCC // TODO REQUIRE (numberOfCoefficients < 25, U"The number of coefficients should be less than 25.")
@@ -613,7 +767,23 @@ PRAAT_CLASS_BINDING(Sound) {
 		    // if (numberOfCoefficients >= 25) Melder_throw(U"The number of coefficients should be less than 25."); // Might be wrong, but I see no reason to enforce this, in the actual code
 		    return Sound_to_MFCC(self, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, maximumFrequency ? static_cast<double>(*maximumFrequency) : 0.0, distanceBetweenFilters);
 	    },
-	    "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFreqency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt);
+	    "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFreqency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt,
+	    py::call_guard<py::gil_scoped_release>());
+
+	def("get_cpps",
+	    [](Sound self, Positive<double> pitchFloor, Positive<double> timeStep, Positive<double> maximumFrequency, Positive<double> preEmphasisFrom, bool subtractTiltBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow, double peakSearchPitchFloor, double peakSearchPitchCeiling, double tiltLineQuefrencyFrom, double tiltLineQuefrencyTo) {
+		    return Sound_getCPPS(self, pitchFloor, timeStep, maximumFrequency, preEmphasisFrom, subtractTiltBeforeSmoothing, timeAveragingWindow, quefrencyAveragingWindow, peakSearchPitchFloor, peakSearchPitchCeiling, 1 /* parabolic */, tiltLineQuefrencyFrom, tiltLineQuefrencyTo, 2 /* exponential decay */, 2 /* robust */);
+	    },
+	    "pitch_floor"_a = 60.0, "time_step"_a = 0.002, "maximum_frequency"_a = 5000.0, "pre_emphasis_from"_a = 50.0,
+	    "subtract_tilt_before_smoothing"_a = true, "time_averaging_window"_a = 0.02, "quefrency_averaging_window"_a = 0.0005,
+	    "peak_search_pitch_floor"_a = 60.0, "peak_search_pitch_ceiling"_a = 330.0, "tilt_line_quefrency_from"_a = 0.001, "tilt_line_quefrency_to"_a = 0.0,
+	    py::call_guard<py::gil_scoped_release>(), R"(Get the smoothed cepstral peak prominence (CPPS) of this Sound.
+
+Returns the same value as "To PowerCepstrogram..." followed by "Get
+CPPS..." in Praat, with a parabolic interpolation of the peak and a
+robust fit of an exponential decay as tilt line, but without keeping
+the intermediate PowerCepstrogram objects around. A
+``tilt_line_quefrency_to`` of 0 means the end of the quefrency range.)");
 
 	// TODO For some reason praat_David_init.cpp also still contains Sound functionality
 	// TODO Still a bunch of Sound in praat_LPC_init.cpp
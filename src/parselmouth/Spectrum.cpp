@@ -250,17 +250,21 @@ PRAAT_CLASS_BINDING(Spectrum) {
 
 	def("cepstral_smoothing",
 	    args_cast<_, Positive<_>>(Spectrum_cepstralSmoothing),
-	    "bandwidth"_a = 500.0);
+	    "bandwidth"_a = 500.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("lpc_smoothing",
 	    args_cast<_, Positive<_>, Positive<_>>(Spectrum_lpcSmoothing),
-	    "num_peaks"_a = 5, "pre_emphasis_from"_a = 50.0);
+	    "num_peaks"_a = 5, "pre_emphasis_from"_a = 50.0,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_sound",
-	    &Spectrum_to_Sound);
+	    &Spectrum_to_Sound,
+	    py::call_guard<py::gil_scoped_release>());
 
 	def("to_spectrogram",
-	    &Spectrum_to_Spectrogram);
+	    &Spectrum_to_Spectrogram,
+	    py::call_guard<py::gil_scoped_release>());
 
 	// TODO More stuff in praat_David_init, for some reason
 }
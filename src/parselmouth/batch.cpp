@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2019  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Parselmouth.h"
+
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/dwtools/Sound_to_MFCC.h>
+#include <praat/fon/Sound_to_Formant.h>
+#include <praat/fon/Sound_to_Harmonicity.h>
+#include <praat/fon/Sound_to_Intensity.h>
+#include <praat/fon/Sound_to_Pitch.h>
+#include <praat/sys/MelderThread.h>
+
+#include <pybind11/stl.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+namespace {
+
+using SoundList = std::vector<std::reference_wrapper<structSound>>;
+
+// Runs the analysis on all Sounds on Praat's thread pool, with the GIL released, and only converts the results back to Python objects afterwards.
+// A PraatError in one of the analyses does not stop the others; depending on returnExceptions, it is either raised (for the first failed Sound) or returned in place of that Sound's result.
+template <typename Result, typename Analysis>
+py::list analyseAll(const SoundList &sounds, bool returnExceptions, Analysis analysis) {
+	auto numberOfSounds = static_cast<integer>(sounds.size());
+	std::vector<autoSomeThing<Result>> results(sounds.size());
+	std::vector<std::u32string> errors(sounds.size());
+
+	{
+		py::gil_scoped_release release;
+		MelderThread_parallelFor(numberOfSounds, 1, MelderThread_getNumberOfThreads(numberOfSounds, 1),
+			[&](integer firstSound, integer lastSound, integer) {
+				for (integer i = firstSound; i <= lastSound; ++i) {
+					try {
+						results[i-1] = analysis(&sounds[i-1].get());
+					}
+					catch (MelderError) {
+						errors[i-1] = Melder_getError(); // Thread-local, so this is the error of this analysis
+						Melder_clearError();
+					}
+				}
+			});
+	}
+
+	py::list list;
+	for (integer i = 1; i <= numberOfSounds; ++i) {
+		if (!errors[i-1].empty()) {
+			if (!returnExceptions) {
+				Melder_appendError_noLine(errors[i-1].c_str());
+				Melder_throw(U"Sound ", i, U" (of ", numberOfSounds, U") could not be analysed.");
+			}
+			std::string message(Melder_peek32to8(errors[i-1].c_str()));
+			if (!message.empty() && message.back() == '\n')
+				message.pop_back(); // Remove closing newline, as for raised PraatErrors
+			list.append(py::module::import("parselmouth").attr("PraatError")(message));
+		}
+		else {
+			list.append(py::cast(std::move(results[i-1])));
+		}
+	}
+	return list;
+}
+
+} // namespace
+
+class BatchModule;
+
+PRAAT_MODULE_BINDING(batch, BatchModule) {
+	doc() = R"(Analyses of multiple Sound objects at once.
+
+Each function in this module corresponds to the `parselmouth.Sound`
+method with the same name and parameters, but takes a list of Sound
+objects. The Sounds are analysed in parallel, on Praat's own thread
+pool, and the results are returned as a list in the same order.
+
+If one of the analyses fails, the other ones still finish. By default,
+a `parselmouth.PraatError` is then raised for the first Sound that
+could not be analysed. With ``return_exceptions=True``, the
+`parselmouth.PraatError` is returned in place of the result of that
+Sound instead.)";
+
+	def("to_pitch",
+	    [](const SoundList &sounds, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<double> pitchCeiling, bool returnExceptions) {
+		    double dt = timeStep ? static_cast<double>(*timeStep) : 0.0;
+		    return analyseAll<structPitch>(sounds, returnExceptions, [&](Sound sound) { return Sound_to_Pitch(sound, dt, pitchFloor, pitchCeiling); });
+	    },
+	    "sounds"_a, "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0, "return_exceptions"_a = false);
+
+	def("to_formant_burg",
+	    [](const SoundList &sounds, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, bool returnExceptions) {
+		    double dt = timeStep ? static_cast<double>(*timeStep) : 0.0;
+		    return analyseAll<structFormant>(sounds, returnExceptions, [&](Sound sound) { return Sound_to_Formant_burg(sound, dt, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom); });
+	    },
+	    "sounds"_a, "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "return_exceptions"_a = false);
+
+	def("to_intensity",
+	    [](const SoundList &sounds, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean, bool fast, bool returnExceptions) {
+		    double dt = timeStep ? static_cast<double>(*timeStep) : 0.0;
+		    auto toIntensity = fast ? Sound_to_Intensity_fast : Sound_to_Intensity;
+		    return analyseAll<structIntensity>(sounds, returnExceptions, [&](Sound sound) { return toIntensity(sound, minimumPitch, dt, subtractMean); });
+	    },
+	    "sounds"_a, "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, "fast"_a = false, "return_exceptions"_a = false);
+
+	def("to_harmonicity_cc",
+	    [](const SoundList &sounds, Positive<double> timeStep, Positive<double> minimumPitch, double silenceThreshold, Positive<double> periodsPerWindow, bool returnExceptions) {
+		    return analyseAll<structHarmonicity>(sounds, returnExceptions, [&](Sound sound) { return Sound_to_Harmonicity_cc(sound, timeStep, minimumPitch, silenceThreshold, periodsPerWindow); });
+	    },
+	    "sounds"_a, "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0, "return_exceptions"_a = false);
+
+	def("to_mfcc", // Same argument order as Sound.to_mfcc, rather than Sound_to_MFCC
+	    [](const SoundList &sounds, Positive<long> numberOfCoefficients, Positive<double> windowLength, Positive<double> timeStep, Positive<double> firstFilterFrequency, Positive<double> distanceBetweenFilters, std::optional<Positive<double>> maximumFrequency, bool returnExceptions) {
+		    double fmax = maximumFrequency ? static_cast<double>(*maximumFrequency) : 0.0;
+		    return analyseAll<structMFCC>(sounds, returnExceptions, [&](Sound sound) { return Sound_to_MFCC(sound, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, fmax, distanceBetweenFilters); });
+	    },
+	    "sounds"_a, "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFreqency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt, "return_exceptions"_a = false);
+}
+
+} // namespace parselmouth
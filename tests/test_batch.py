@@ -0,0 +1,53 @@
+import pytest
+
+import parselmouth
+import numpy as np
+
+
+BATCH_ANALYSES = {
+	'to_pitch': lambda p: p.selected_array['frequency'],
+	'to_formant_burg': lambda f: [f.get_value_at_time(1, t) for t in f.xs()],
+	'to_intensity': lambda i: i.values,
+	'to_harmonicity_cc': lambda h: h.values,
+	'to_mfcc': lambda m: m.to_array(),
+}
+
+
+@pytest.fixture(params=sorted(BATCH_ANALYSES))
+def batch_analysis(request):
+	yield request.param, BATCH_ANALYSES[request.param]
+
+
+def test_batch_matches_single(sound, batch_analysis):
+	name, values = batch_analysis
+	sounds = [sound.extract_part(0, 0.5 * (i + 1)) for i in range(6)]
+	results = getattr(parselmouth.batch, name)(sounds)
+	assert len(results) == len(sounds)
+	for s, result in zip(sounds, results):
+		assert np.array_equal(values(result), values(getattr(s, name)()), equal_nan=True)
+
+
+def test_batch_arguments(sound):
+	results = parselmouth.batch.to_pitch([sound, sound], time_step=0.02, pitch_floor=100)
+	expected = sound.to_pitch(time_step=0.02, pitch_floor=100)
+	for result in results:
+		assert result.dt == expected.dt
+		assert np.array_equal(result.selected_array['frequency'], expected.selected_array['frequency'])
+
+
+def test_batch_errors(sound):
+	sounds = [sound, sound.extract_part(0, 0.01), sound]
+	with pytest.raises(parselmouth.PraatError, match=r"Sound 2 \(of 3\) could not be analysed"):
+		parselmouth.batch.to_pitch(sounds)
+
+	results = parselmouth.batch.to_pitch(sounds, return_exceptions=True)
+	assert isinstance(results[0], parselmouth.Pitch) and isinstance(results[2], parselmouth.Pitch)
+	assert isinstance(results[1], parselmouth.PraatError)
+	with pytest.raises(parselmouth.PraatError) as excinfo:
+		sounds[1].to_pitch()
+	assert str(results[1]) == str(excinfo.value)
+	assert str(results[1]).endswith("pitch analysis not performed.")  # Only the closing newline is removed
+
+
+def test_batch_empty():
+	assert parselmouth.batch.to_intensity([]) == []
@@ -3,6 +3,7 @@ from __future__ import unicode_literals  # Python 2 compatibility
 import pytest
 
 import parselmouth
+import numpy as np
 
 from future.utils import text_to_native_str  # Python 2 compatibility
 
@@ -17,3 +18,37 @@ def test_read_nonexistent():
 
 
 # TODO Other encodings
+
+
+@pytest.fixture
+def portable_binary_io():
+	parselmouth.praat.call("Debug...", False, 18)  # Read and write binary files number by number, without any machine-specific shortcuts
+	yield
+	parselmouth.praat.call("Debug...", False, 0)
+
+
+@pytest.mark.parametrize('values', [
+	np.array([[0.0, -0.0, 1.0, -1.5, np.pi, 1e300, -1e-300, 5e-324, -2e-310, np.inf, -np.inf, np.nan]]),
+	np.random.RandomState(42).normal(size=(3, 10000)),
+])
+def test_binary_file_round_trip(values, tmp_path, portable_binary_io):
+	sound = parselmouth.Sound(values, sampling_frequency=1)
+	sound.save_as_binary_file(str(tmp_path / "portable.Sound"))
+	portable = parselmouth.read(str(tmp_path / "portable.Sound"))
+	parselmouth.praat.call("Debug...", False, 0)
+	sound.save_as_binary_file(str(tmp_path / "fast.Sound"))
+	fast = parselmouth.read(str(tmp_path / "fast.Sound"))
+	assert (tmp_path / "fast.Sound").read_bytes() == (tmp_path / "portable.Sound").read_bytes()
+	assert np.array_equal(fast.values, portable.values, equal_nan=True)
+	assert np.array_equal(np.signbit(fast.values), np.signbit(portable.values))
+
+
+def test_binary_file_round_trip_float32(sound, tmp_path, portable_binary_io):
+	mfcc = sound.to_mfcc()
+	mfcc.save_as_binary_file(str(tmp_path / "portable.MFCC"))
+	portable = parselmouth.read(str(tmp_path / "portable.MFCC"))
+	parselmouth.praat.call("Debug...", False, 0)
+	mfcc.save_as_binary_file(str(tmp_path / "fast.MFCC"))
+	fast = parselmouth.read(str(tmp_path / "fast.MFCC"))
+	assert (tmp_path / "fast.MFCC").read_bytes() == (tmp_path / "portable.MFCC").read_bytes()
+	assert np.array_equal(fast.to_array(), portable.to_array())
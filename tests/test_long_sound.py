@@ -0,0 +1,59 @@
+import pytest
+
+import parselmouth
+import numpy as np
+
+
+@pytest.fixture
+def long_sound(sound_path):
+	yield parselmouth.LongSound(sound_path)
+
+
+def test_long_sound(long_sound, sound):
+	assert long_sound.xmin == sound.xmin and long_sound.xmax == sound.xmax
+	assert long_sound.n_channels == sound.n_channels
+	assert long_sound.sampling_frequency == sound.sampling_frequency
+	assert np.array_equal(long_sound.extract_part(0.25, 0.75).values, sound.extract_part(0.25, 0.75).values)
+
+
+@pytest.mark.parametrize('segment_duration', [0.1, 0.35, 10])
+def test_to_pitch_segments(long_sound, sound, segment_duration):
+	pitch = sound.to_pitch()
+	segments = list(long_sound.to_pitch_segments(segment_duration=segment_duration))
+
+	assert segments[0].xmin == pitch.xmin and segments[-1].xmax == pitch.xmax
+	for previous, segment in zip(segments, segments[1:]):
+		assert previous.xmax == segment.xmin
+	assert np.allclose(np.concatenate([segment.xs() for segment in segments]), pitch.xs())
+
+	frames = [frame for segment in segments for frame in segment]
+	assert len(frames) == len(pitch)
+	for frame, expected in zip(frames, pitch):
+		assert frame.intensity == expected.intensity
+		assert np.array_equal(frame.as_array(), expected.as_array())
+
+
+def test_to_pitch_segments_arguments(long_sound):
+	with pytest.raises(parselmouth.PraatError, match="“minimum pitch” must not be less than"):
+		long_sound.to_pitch_segments(pitch_floor=1)
+
+	segments = long_sound.to_pitch_segments(time_step=0.05, segment_duration=0.5)
+	assert iter(segments) is segments
+	assert next(segments).nx == 10
+	with pytest.raises(StopIteration):
+		while True:
+			next(segments)
+
+
+@pytest.mark.parametrize('fast', [False, True])
+def test_to_intensity(sound, tmp_path, fast):
+	sound = parselmouth.Sound(np.tile(sound.values, 50), sampling_frequency=sound.sampling_frequency)  # More than a minute, i.e. several parts
+	sound.save(str(tmp_path / "long.wav"), "WAV")
+	sound = parselmouth.read(str(tmp_path / "long.wav"))
+	long_sound = parselmouth.LongSound(str(tmp_path / "long.wav"))
+
+	intensity = long_sound.to_intensity(fast=fast)
+	expected = sound.to_intensity(fast=fast)
+	assert intensity.xmin == expected.xmin and intensity.xmax == expected.xmax
+	assert intensity.nx == expected.nx and intensity.x1 == expected.x1 and intensity.dx == expected.dx
+	assert np.array_equal(intensity.values, expected.values)
@@ -3,6 +3,8 @@ import pytest
 import parselmouth
 import numpy as np
 
+import tracemalloc
+
 
 @pytest.fixture(params=[100, 16000, 44100])
 def sampling_frequency(request):
@@ -36,3 +38,85 @@ def test_from_scalar(sampling_frequency):
 
 	with pytest.raises(ValueError, match="Cannot create Sound from a single 0-dimensional number"):
 		parselmouth.Sound(3.14159, sampling_frequency=sampling_frequency)
+
+
+@pytest.mark.parametrize('dtype', [np.float64, np.float32, np.int16, np.int32, np.int64, np.uint8])
+@pytest.mark.parametrize('order', ['C', 'F'])
+def test_from_numpy_array_types(dtype, order):
+	values = np.random.RandomState(42).uniform(-100, 100, (3, 1000)).astype(dtype, order=order)
+	sound = parselmouth.Sound(values)
+	assert np.all(sound.values == values.astype(np.float64))
+	assert np.all(parselmouth.Sound(values[1]).values == values[1].astype(np.float64))
+	assert np.all(parselmouth.Sound(values[:, ::-3]).values == values[:, ::-3].astype(np.float64))
+
+
+@pytest.mark.parametrize('dtype', [np.float64, np.float32, np.int16, np.int32])
+@pytest.mark.parametrize('sampling_frequency, start_time', [(16000, 0), (16000.0, 0.0), (16000, 1.5)])
+def test_from_numpy_array_without_float64_copy(dtype, sampling_frequency, start_time):
+	values = np.ones((2, 1000000), dtype=dtype, order='F')
+	tracemalloc.start()
+	try:
+		sound = parselmouth.Sound(values, sampling_frequency, start_time)
+		peak = tracemalloc.get_traced_memory()[1]
+	finally:
+		tracemalloc.stop()
+	assert peak < values.size * np.dtype(np.float64).itemsize / 10  # NumPy reports its allocations to tracemalloc; a Sound's own samples are not
+	assert sound.sampling_frequency == 16000 and sound.xmin == start_time
+	assert np.all(sound.values == 1)
+
+
+def test_from_list():
+	assert np.all(parselmouth.Sound([1, 2, 3]).values == [[1, 2, 3]])
+	assert np.all(parselmouth.Sound([[1.5, 2], [3, 4]]).values == [[1.5, 2], [3, 4]])
+
+
+@pytest.mark.parametrize('method, attenuation', [("POLYPHASE_FAST", 40), ("POLYPHASE_MEDIUM", 75), ("POLYPHASE_BEST", 115)])
+@pytest.mark.parametrize('new_frequency', [16000, 22050, 96000])
+def test_resample_polyphase(method, attenuation, new_frequency):
+	sampling_frequency = 44100
+	t = (np.arange(2 * sampling_frequency) + 0.5) / sampling_frequency
+	sound = parselmouth.Sound([np.sin(2 * np.pi * 440 * t), np.sin(2 * np.pi * 12000 * t)], sampling_frequency)
+
+	resampled = sound.resample(new_frequency, method=method)
+	expected = sound.resample(new_frequency)
+	assert resampled.xmin == expected.xmin and resampled.xmax == expected.xmax
+	assert resampled.nx == expected.nx and resampled.x1 == expected.x1 and resampled.dx == expected.dx
+
+	interior = slice(new_frequency // 10, -new_frequency // 10)
+	t = resampled.xs()[interior]
+	assert np.max(np.abs(resampled.values[0, interior] - np.sin(2 * np.pi * 440 * t))) < 10**(-attenuation / 20)
+	above_nyquist = 12000 > new_frequency / 2
+	assert np.max(np.abs(resampled.values[1, interior] - (0 if above_nyquist else np.sin(2 * np.pi * 12000 * t)))) < 10**(-attenuation / 20)
+
+
+@pytest.mark.parametrize('method', ["POLYPHASE_FAST", "POLYPHASE_MEDIUM", "POLYPHASE_BEST"])
+def test_resample_polyphase_ignores_precision(method):
+	sound = parselmouth.Sound(np.random.RandomState(42).normal(size=4410), 44100)
+	expected = sound.resample(16000, method=method)
+	for precision in [1, 2, 1000]:
+		assert np.array_equal(sound.resample(16000, precision, method=method).values, expected.values)
+
+
+def test_resample_polyphase_constant():
+	sound = parselmouth.Sound(np.full(44100, 0.5), 44100)
+	resampled = sound.resample(16000, method=parselmouth.Sound.ResampleMethod.POLYPHASE_MEDIUM)
+	assert np.allclose(resampled.values[0, 1000:-1000], 0.5, rtol=0, atol=1e-12)
+
+
+@pytest.mark.parametrize("n_samples1, n_samples2", [(5000, 7), (300, 40000), (1000, 1200), (1, 1)])
+def test_convolve_cross_correlate(n_samples1, n_samples2):
+	random = np.random.RandomState(42)
+	values1, values2 = random.normal(size=(2, n_samples1)), random.normal(size=(1, n_samples2))
+	sound1, sound2 = parselmouth.Sound(values1, 1000), parselmouth.Sound(values2, 1000)
+
+	convolved = sound1.convolve(sound2, scaling="SUM")
+	assert convolved.n_channels == 2 and convolved.n_samples == n_samples1 + n_samples2 - 1
+	for channel in range(2):
+		assert np.allclose(convolved.values[channel], np.convolve(values1[channel], values2[0]), rtol=0, atol=1e-10)
+
+	cross_correlated = sound1.cross_correlate(sound2, scaling="SUM")
+	for channel in range(2):
+		assert np.allclose(cross_correlated.values[channel], np.correlate(values2[0], values1[channel], mode='full'), rtol=0, atol=1e-10)
+
+	autocorrelated = sound2.autocorrelate(scaling="SUM")
+	assert np.allclose(autocorrelated.values[0], np.correlate(values2[0], values2[0], mode='full'), rtol=0, atol=1e-10)
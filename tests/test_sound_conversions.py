@@ -1,6 +1,8 @@
 import pytest
 
 import parselmouth
+import numpy as np
+import re
 
 
 def test_sound_to_pitch(sound):
@@ -11,3 +13,205 @@ def test_sound_to_pitch(sound):
 
 	assert fragment.to_pitch(pitch_floor=50.0, method=parselmouth.Sound.ToPitchMethod.AC) == fragment.to_pitch_ac(pitch_floor=50)
 	assert fragment.to_pitch("CC", pitch_ceiling=300) == fragment.to_pitch_cc(pitch_ceiling=300.0)
+
+
+@pytest.fixture
+def three_threads():
+	parselmouth.set_num_threads(3)
+	yield
+	parselmouth.set_num_threads()
+
+
+@pytest.mark.parametrize('number_of_threads', [1, 2, 3, 16])
+def test_sound_to_formant_burg_number_of_threads(sound, number_of_threads, three_threads):
+	assert parselmouth.get_num_threads() == 3  # also on machines with fewer processors, so that the pool really runs in parallel
+	with parselmouth.limit_num_threads(1):
+		expected = sound.to_formant_burg()
+	assert sound.to_formant_burg(number_of_threads=number_of_threads) == expected
+	assert sound.to_formant_burg() == expected
+
+
+@pytest.mark.parametrize('subtract_mean', [True, False])
+@pytest.mark.parametrize('relative_offset', [0, 1, 1e6])  # Sound_to_Intensity_fast promises 1e-6 dB up to a mean of 1e6 times the deviations
+@pytest.mark.parametrize('n_channels', [1, 2])
+@pytest.mark.parametrize('time_step', [None, 0.001])
+def test_sound_to_intensity_fast(sound, subtract_mean, relative_offset, n_channels, time_step):
+	values = np.vstack([sound.values, 0.5 * sound.values[:, ::-1]][:n_channels])
+	sound = parselmouth.Sound(values + relative_offset * np.std(values), sampling_frequency=sound.sampling_frequency)
+	intensity = sound.to_intensity(time_step=time_step, subtract_mean=subtract_mean)
+	fast_intensity = sound.to_intensity(time_step=time_step, subtract_mean=subtract_mean, fast=True)
+	assert fast_intensity.xs() == pytest.approx(intensity.xs())
+	assert np.allclose(fast_intensity.values, intensity.values, rtol=0, atol=1e-6)
+
+
+@pytest.mark.parametrize('very_accurate', [True, False])
+def test_sound_to_pitch_cc_fast(sound, very_accurate):
+	pitch = sound.to_pitch_cc(very_accurate=very_accurate)
+	fast_pitch = sound.to_pitch_cc(very_accurate=very_accurate, fast=True)
+	assert np.allclose(fast_pitch.selected_array['frequency'], pitch.selected_array['frequency'], rtol=1e-6, atol=0)
+	assert np.allclose(fast_pitch.selected_array['strength'], pitch.selected_array['strength'], rtol=1e-9, atol=1e-12)
+
+
+@pytest.fixture(params=[0, 52, 53], ids=["vectorized", "fftpack", "vectorized_without_avx2"])
+def fft_backend(request):
+	parselmouth.praat.call("Debug...", False, request.param)
+	yield
+	parselmouth.praat.call("Debug...", False, 0)
+
+
+@pytest.mark.parametrize('n_samples', [2, 64, 128, 1000, 1024, 2**16, 2**21])
+def test_sound_to_spectrum_fft(fft_backend, n_samples):
+	values = np.random.RandomState(42).normal(size=n_samples)
+	sound = parselmouth.Sound(values, sampling_frequency=1000)
+	spectrum = sound.to_spectrum(fast=False)
+	expected = np.fft.rfft(values) * sound.dx
+	assert np.allclose(spectrum.values[0] + 1j * spectrum.values[1], expected, rtol=0, atol=1e-12 * np.max(np.abs(expected)))
+	assert np.allclose(spectrum.to_sound().values[0], values, rtol=0, atol=1e-12)
+
+
+FFT_ANALYSES = {
+	'to_spectrum': lambda s: s.to_spectrum().values,
+	'to_spectrum_prime': lambda s: s.extract_part(0, 1009 * s.dx).to_spectrum(fast=False).values,
+	'to_pitch_ac': lambda s: s.to_pitch_ac().selected_array['frequency'],
+	'to_spectrogram': lambda s: s.to_spectrogram().values,
+	'to_mfcc': lambda s: s.to_mfcc().to_array(),
+}
+
+
+@pytest.mark.parametrize('analysis', sorted(FFT_ANALYSES))
+def test_fft_backends_agree(sound, analysis):
+	def analyse(debug):
+		parselmouth.praat.call("Debug...", False, debug)
+		try:
+			return FFT_ANALYSES[analysis](sound)
+		finally:
+			parselmouth.praat.call("Debug...", False, 0)
+
+	vectorized, without_avx2, fftpack = analyse(0), analyse(53), analyse(52)
+	assert np.array_equal(vectorized, without_avx2, equal_nan=True)  # Multiply-adds are never fused, so the AVX2 variant rounds the same
+	assert np.allclose(vectorized, fftpack, rtol=1e-9, atol=1e-9 * np.nanmax(np.abs(fftpack)), equal_nan=True)
+
+
+@pytest.mark.parametrize('fft_backend', [0, 53], ids=["vectorized", "vectorized_without_avx2"], indirect=True)  # Prime sizes this large take Bluestein's algorithm, except with FFTPACK only
+@pytest.mark.parametrize('n_samples', [1009, 4099, 65537])
+def test_sound_to_spectrum_fft_prime(fft_backend, n_samples):
+	values = np.random.RandomState(42).normal(size=n_samples)
+	sound = parselmouth.Sound(values, sampling_frequency=1000)
+	spectrum = sound.to_spectrum(fast=False)
+	expected = np.fft.rfft(values) * sound.dx
+	assert np.allclose(spectrum.values[0] + 1j * spectrum.values[1], expected, rtol=0, atol=1e-12 * np.max(np.abs(expected)))
+	assert np.allclose(spectrum.to_sound().values[0], values, rtol=0, atol=1e-12)
+
+
+@pytest.mark.parametrize('n_samples', [1009, 44101, 100003])
+def test_sound_to_spectrum_padding(n_samples):
+	values = np.random.RandomState(42).normal(size=n_samples)
+	sound = parselmouth.Sound(values, sampling_frequency=1000)
+	assert sound.to_spectrum(padding="NONE") == sound.to_spectrum(fast=False)
+	assert sound.to_spectrum(padding="POWER_OF_TWO") == sound.to_spectrum(fast=True)
+	for padding, expected_n_samples in [("NONE", n_samples), ("FAST_SIZE", {1009: 1024, 44101: 44800, 100003: 100352}[n_samples])]:
+		spectrum = sound.to_spectrum(padding=padding)
+		assert spectrum.n_bins == expected_n_samples // 2 + 1
+		expected = np.fft.rfft(values, expected_n_samples) * sound.dx
+		assert np.allclose(spectrum.values[0] + 1j * spectrum.values[1], expected, rtol=0, atol=1e-12 * np.max(np.abs(expected)))
+
+
+@pytest.mark.parametrize('n_samples', [1000, 1009, 1024, 2**21])
+def test_fft_plan_cache(fft_backend, n_samples):
+	def fft_plan_cache_counts():
+		report = parselmouth.praat.call("Report memory use")
+		hits, misses = re.search(r"FFT plans: \d+ \([\d,]+ bytes; (\d+) hits, (\d+) misses\)", report).groups()
+		return int(hits), int(misses)
+
+	sound = parselmouth.Sound(np.random.RandomState(42).normal(size=n_samples), sampling_frequency=1000)
+	spectrum = sound.to_spectrum(fast=False)
+	hits, misses = fft_plan_cache_counts()
+	assert sound.to_spectrum(fast=False) == spectrum
+	assert fft_plan_cache_counts() == (hits + 1, misses)
+
+
+@pytest.mark.parametrize('subtract_tilt, baseline_cpps', [(True, 9.28640387984691), (False, 8.48942416134957)])  # Computed with Praat's serial Sound_to_PowerCepstrogram and PowerCepstrogram_getCPPS
+def test_sound_get_cpps(sound, subtract_tilt, baseline_cpps):
+	cepstrogram = parselmouth.praat.call(sound, "To PowerCepstrogram", 60.0, 0.002, 5000.0, 50.0)
+	expected = parselmouth.praat.call(cepstrogram, "Get CPPS", subtract_tilt, 0.02, 0.0005, 60.0, 330.0, 0.05, "Parabolic", 0.001, 0.0, "Exponential decay", "Robust")
+	assert expected == pytest.approx(baseline_cpps, rel=1e-12)
+	assert sound.get_cpps(subtract_tilt_before_smoothing=subtract_tilt) == expected
+	with parselmouth.limit_num_threads(1):
+		assert parselmouth.praat.call(sound, "To PowerCepstrogram", 60.0, 0.002, 5000.0, 50.0) == cepstrogram
+		assert sound.get_cpps(subtract_tilt_before_smoothing=subtract_tilt) == expected
+
+
+def matrix_summary(matrix):
+	return (parselmouth.praat.call(matrix, "Get sum"), parselmouth.praat.call(matrix, "Get value in cell", 10, 100), parselmouth.praat.call(matrix, "Get maximum"))
+
+
+# Baseline values from before the filter banks were cached and applied to blocks of frames; these differ by the rounding of the FFT only
+@pytest.mark.parametrize('command, arguments, to_matrix_arguments, baseline_summary', [("To MelSpectrogram", (0.015, 0.005, 100.0, 100.0, 0.0), (False,), (3.7921827364557275, 6.517607253900204e-05, 0.0535744395429505)),
+                                                                                     ("To BarkSpectrogram", (0.015, 0.005, 1.0, 1.0, 0.0), (False,), (4.362407326186286, 1.6792904523728044e-05, 0.06134808625786467)),
+                                                                                     ("To Spectrogram (pitch-dependent)", (0.015, 0.005, 100.0, 50.0, 0.0, 1.1, 75.0, 600.0), (), (23.209490481810313, 0.0319891931831843, 0.08112830640970846))])
+def test_sound_to_band_filter_spectrogram_number_of_threads(sound, command, arguments, to_matrix_arguments, baseline_summary):
+	spectrogram = parselmouth.praat.call(sound, command, *arguments)
+	assert matrix_summary(parselmouth.praat.call(spectrogram, "To Matrix", *to_matrix_arguments)) == pytest.approx(baseline_summary, rel=1e-9)
+	assert parselmouth.praat.call(sound, command, *arguments) == spectrogram  # with the cached filter bank
+	with parselmouth.limit_num_threads(1):
+		assert parselmouth.praat.call(sound, command, *arguments) == spectrogram
+		assert sound.to_mfcc() == parselmouth.praat.call(parselmouth.praat.call(sound, "To MelSpectrogram", 0.015, 0.005, 100.0, 100.0, 0.0), "To MFCC", 12)
+
+
+# Baseline values from before the MFCCs were computed straight from the filter outputs (the baseline crashed with a Mel step of 150)
+@pytest.mark.parametrize('arguments, baseline_summary', [((12, 0.015, 0.005, 100.0, 100.0, 0.0), (68868.72225309876, -43.16001735495444, 496.24570034043586)),
+                                                         ((24, 0.025, 0.01, 200.0, 50.0, 3000.0), (45288.854927095934, 23.004964212381665, 639.9336071775277)),
+                                                         ((12, 0.015, 0.005, 100.0, 150.0, 0.0), None)])
+def test_sound_to_mfcc(sound, arguments, baseline_summary):
+	number_of_coefficients, *mel_arguments = arguments
+	mel_spectrogram = parselmouth.praat.call(sound, "To MelSpectrogram", *mel_arguments)
+	expected = parselmouth.praat.call(mel_spectrogram, "To MFCC", number_of_coefficients)
+	if baseline_summary is not None:
+		assert matrix_summary(parselmouth.praat.call(expected, "To Matrix")) == pytest.approx(baseline_summary, rel=1e-9)
+	assert parselmouth.praat.call(sound, "To MFCC", *arguments) == expected
+	with parselmouth.limit_num_threads(1):
+		assert parselmouth.praat.call(sound, "To MFCC", *arguments) == expected
+
+
+def test_mfcc_to_matrix_with_deltas(sound):
+	mfcc = sound.to_mfcc(number_of_coefficients=12)
+	cepstra = mfcc.to_array()
+	with_deltas = mfcc.to_matrix_with_deltas(number_of_frames_each_side=2).values
+	assert with_deltas.shape == (3 * 13, mfcc.n_frames)
+	assert np.array_equal(with_deltas[:13], cepstra)
+
+	def regression(values, m):
+		padded = np.pad(values, ((0, 0), (m, m)), mode='edge')
+		n = values.shape[1]
+		return sum(k * (padded[:, m + k:m + k + n] - padded[:, m - k:m - k + n]) for k in range(1, m + 1)) / (2 * sum(k * k for k in range(1, m + 1)))
+
+	deltas = regression(cepstra, 2)
+	assert np.allclose(with_deltas[13:26], deltas)
+	assert np.allclose(with_deltas[26:], regression(deltas, 2))
+	assert mfcc.to_matrix_with_deltas(number_of_frames_each_side=1, include_delta_deltas=False).values.shape == (2 * 13, mfcc.n_frames)
+
+
+# 51 bands in groups of 1, 3 and 10, and 161 bands in groups of 50: the envelopes of every earlier group of bands are computed again
+@pytest.mark.parametrize('arguments, max_bands_in_memory_values', [((500.0, 4500.0, 1000.0, 80.0), [2, 7, 20]), ((100.0, 4900.0, 200.0, 30.0), [100])])
+def test_sound_to_harmonicity_gne(sound, arguments, max_bands_in_memory_values):
+	sound = sound.extract_part(0.5, 1.5)
+	expected = parselmouth.praat.call(sound, "To Harmonicity (gne)", *arguments)
+	assert expected.n_rows == len(np.arange(arguments[0], arguments[1] + 1e-9, arguments[3]))
+	assert sound.to_harmonicity_gne(*arguments) == expected
+	for max_bands_in_memory in max_bands_in_memory_values:
+		assert sound.to_harmonicity_gne(*arguments, max_bands_in_memory=max_bands_in_memory) == expected
+	with parselmouth.limit_num_threads(1):
+		assert sound.to_harmonicity_gne(*arguments) == expected
+	with pytest.raises(parselmouth.PraatError, match="at least 2"):
+		sound.to_harmonicity_gne(*arguments, max_bands_in_memory=1)
+
+
+# Baseline values from before the envelopes were computed in parallel. The sound is at 10 kHz already, so that it is not resampled;
+# the inverse filtering with a 13th-order LPC still magnifies the rounding differences of the vectorized FFT a thousandfold or so
+@pytest.mark.parametrize('arguments, max_bands_in_memory, baseline_summary', [((500.0, 4500.0, 1000.0, 80.0), 20, (740.1403269662999, 0.7900215197855244, 0.865404399614179)),
+                                                                             ((1000.0, 4000.0, 600.0, 100.0), 8, (304.0524072101544, 0.583533133873946, 0.8580121086755484))])
+def test_sound_to_harmonicity_gne_baseline(sound, arguments, max_bands_in_memory, baseline_summary):
+	sound = sound.extract_part(0.5, 1.5).resample(10000, 50)
+	expected = parselmouth.praat.call(sound, "To Harmonicity (gne)", *arguments)
+	assert (parselmouth.praat.call(expected, "Get sum"), parselmouth.praat.call(expected, "Get value in cell", 30, 10), parselmouth.praat.call(expected, "Get maximum")) == pytest.approx(baseline_summary, rel=1e-6)
+	assert sound.to_harmonicity_gne(*arguments, max_bands_in_memory=max_bands_in_memory) == expected
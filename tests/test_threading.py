@@ -0,0 +1,155 @@
+import pytest
+
+import parselmouth
+import numpy as np
+
+import concurrent.futures
+import os
+import threading
+import time
+
+
+ANALYSES = {
+	'to_pitch_ac': lambda s: s.to_pitch_ac().selected_array['frequency'],
+	'to_pitch_cc': lambda s: s.to_pitch_cc().selected_array['frequency'],
+	'to_intensity': lambda s: s.to_intensity().values,
+	'to_harmonicity_cc': lambda s: s.to_harmonicity_cc().values,
+	'to_formant_burg': lambda s: (lambda f: [f.get_value_at_time(1, t) for t in f.xs()])(s.to_formant_burg()),
+	'to_spectrogram': lambda s: s.to_spectrogram().values,
+	'to_spectrum': lambda s: s.to_spectrum().values,
+	'to_mfcc': lambda s: s.to_mfcc().to_array(),
+}
+
+
+@pytest.fixture(params=sorted(ANALYSES))
+def analysis(request):
+	yield ANALYSES[request.param]
+
+
+def test_concurrent_results_match_serial(sound, analysis):
+	expected = analysis(sound)
+	with concurrent.futures.ThreadPoolExecutor(4) as executor:
+		results = list(executor.map(analysis, [sound] * 8))
+	for result in results:
+		assert np.array_equal(result, expected, equal_nan=True)
+
+
+def test_concurrent_errors(sound):
+	parts = [sound.extract_part(0, 0.1 * (i + 1)) for i in range(8)]
+
+	def failing_analysis(part):
+		with pytest.raises(parselmouth.PraatError) as excinfo:
+			part.to_pitch_ac(pitch_floor=1)
+		return str(excinfo.value)
+
+	expected = [failing_analysis(part) for part in parts]
+	with concurrent.futures.ThreadPoolExecutor(4) as executor:
+		messages = list(executor.map(failing_analysis, parts * 4))
+	assert messages == expected * 4
+
+
+def test_analysis_releases_gil(sound):
+	durations = []
+
+	def analyse():
+		start = time.perf_counter()
+		sound.to_pitch_cc()
+		durations.append(time.perf_counter() - start)
+
+	thread = threading.Thread(target=analyse)
+	timestamps = [time.perf_counter()]
+	thread.start()
+	while thread.is_alive():  # The main thread keeps running Python code while the analysis runs, also on a single processor
+		timestamps.append(time.perf_counter())
+	thread.join()
+	assert len(timestamps) > 1000
+	assert max(np.diff(timestamps)) < 0.5 * durations[0]
+
+
+@pytest.mark.skipif((os.cpu_count() or 1) < 4, reason="thread scaling needs at least 4 processors")
+def test_thread_scaling(sound):
+	sounds = [sound.copy() for _ in range(16)]
+	analysis = lambda s: s.to_pitch_cc()
+
+	start = time.perf_counter()
+	for s in sounds:
+		analysis(s)
+	serial_time = time.perf_counter() - start
+
+	start = time.perf_counter()
+	with concurrent.futures.ThreadPoolExecutor(4) as executor:
+		list(executor.map(analysis, sounds))
+	parallel_time = time.perf_counter() - start
+
+	assert serial_time / parallel_time > 2
+
+
+@pytest.fixture
+def restore_num_threads():
+	yield
+	parselmouth.set_num_threads()
+
+
+def test_get_num_threads():
+	assert parselmouth.get_num_threads() >= 1
+
+
+def test_set_num_threads(restore_num_threads):
+	parselmouth.set_num_threads(3)
+	assert parselmouth.get_num_threads() == 3
+	parselmouth.set_num_threads(1)
+	assert parselmouth.get_num_threads() == 1
+	with pytest.raises(TypeError, match="incompatible function arguments"):
+		parselmouth.set_num_threads(0)
+
+
+def test_limit_num_threads(restore_num_threads):
+	parselmouth.set_num_threads(4)
+	with parselmouth.limit_num_threads(2):
+		assert parselmouth.get_num_threads() == 2
+		with parselmouth.limit_num_threads(1):
+			assert parselmouth.get_num_threads() == 1
+		assert parselmouth.get_num_threads() == 2
+	assert parselmouth.get_num_threads() == 4
+	with parselmouth.limit_num_threads(8):
+		assert parselmouth.get_num_threads() == 4
+
+
+def test_limit_num_threads_per_thread(restore_num_threads):
+	parselmouth.set_num_threads(4)
+	other = []
+	with parselmouth.limit_num_threads(1):
+		thread = threading.Thread(target=lambda: other.append(parselmouth.get_num_threads()))
+		thread.start()
+		thread.join()
+	assert other == [4]
+
+
+def test_results_independent_of_threads(sound, restore_num_threads):
+	parselmouth.set_num_threads(4)
+	expected = sound.to_pitch().selected_array['frequency']
+	with parselmouth.limit_num_threads(1):
+		assert np.array_equal(sound.to_pitch().selected_array['frequency'], expected)
+
+
+def test_set_num_threads_during_analysis(sound, restore_num_threads):
+	expected = sound.to_pitch_cc().selected_array['frequency']
+	stop = threading.Event()
+
+	def analyse():
+		results = []
+		while not stop.is_set():
+			results.append(sound.to_pitch_cc().selected_array['frequency'])
+		return results
+
+	with concurrent.futures.ThreadPoolExecutor(2) as executor:
+		futures = [executor.submit(analyse) for _ in range(2)]
+		for number_of_threads in [1, 3, 2, 4] * 5:
+			try:
+				parselmouth.set_num_threads(number_of_threads)
+			except parselmouth.PraatError as e:
+				assert "while an analysis is running" in str(e)
+			time.sleep(0.01)
+		stop.set()
+		results = [result for future in futures for result in future.result()]
+	assert all(np.array_equal(result, expected, equal_nan=True) for result in results)
@@ -0,0 +1,63 @@
+import pytest
+
+import parselmouth
+import numpy as np
+
+import gc
+
+
+def test_sampled_values_view(sound, intensity):
+	for sampled in [sound, intensity]:
+		values = sampled.values
+		assert not values.flags.owndata
+		assert np.shares_memory(values, np.asarray(memoryview(sampled)))
+		values[0, 0] += 1
+		assert sampled.values[0, 0] == values[0, 0]
+
+
+def test_pitch_frame_view(pitch):
+	frame = pitch[len(pitch) // 2]
+	array = frame.as_array()
+	assert not array.flags.owndata
+	assert len(array) == len(frame)
+	assert array.dtype.names == ('frequency', 'strength')
+	assert np.shares_memory(array, np.asarray(memoryview(frame)))
+	assert [c.frequency for c in frame.candidates] == list(array['frequency'])
+
+	frame.unvoice()
+	assert array[0]['frequency'] == 0
+
+
+def test_formant_frame_view(sound):
+	formant = sound.to_formant_burg()
+	assert len(list(formant)) == len(formant)
+
+	frame = formant.get_frame(len(formant) // 2)
+	assert frame.as_array().base is frame
+	assert np.shares_memory(frame.as_array(), np.asarray(memoryview(frame)))
+	t = formant.xs()[len(formant) // 2 - 1]
+	assert list(frame.as_array()['frequency']) == [formant.get_value_at_time(i + 1, t) for i in range(len(frame))]
+	assert list(frame.as_array()['bandwidth']) == [formant.get_bandwidth_at_time(i + 1, t) for i in range(len(frame))]
+
+	with pytest.raises(IndexError):
+		formant[len(formant)]
+
+
+def test_empty_frame_views(tmp_path):
+	formant = parselmouth.Sound(np.zeros(1600), 16000).to_formant_burg()
+	pitch_file = tmp_path / "empty.Pitch"
+	pitch_file.write_text('File type = "ooTextFile"\nObject class = "Pitch 1"\n\n0 0.1 1 0.1 0.05 600 1\n0 0\n')
+	pitch = parselmouth.read(str(pitch_file))
+
+	for frame in [formant.get_frame(1), pitch[0]]:
+		assert len(frame) == 0
+		assert len(frame.as_array()) == 0
+		assert len(np.asarray(memoryview(frame))) == 0
+	assert pitch[0].candidates == []
+	assert pitch[0].selected is None
+
+
+def test_view_keeps_owner_alive(sound):
+	array = sound.to_formant_burg()[0].as_array()
+	gc.collect()
+	assert np.all(np.isfinite(array['frequency']))